@@ -0,0 +1,118 @@
+/*
+ *  batch_gcd.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * Bernstein's batch gcd.  For x_1, ..., x_n it finds every
+ *	gcd(x_i, product of the others) from a product tree (each node the
+ *	product of its two children) and a remainder tree of squares (each
+ *	node the parent reduced modulo the square of the node), which is
+ *	quasi-linear in the total size instead of n^2 gcds.  The nodes of
+ *	a level are independent, so each level is split between threads.
+ *	T should be a wide integer type; the root holds the whole product.
+ */
+
+#ifndef BATCH_GCD_H
+#define BATCH_GCD_H
+
+#include <vector>
+#include <iterator>
+#include <stdexcept>
+#include <cstddef>
+
+#include "gcd.h"
+#include "parallel.h"
+
+namespace num
+{
+	// levels[0] is the input and levels.back() holds the single product.
+	//	an odd node at the end of a level is carried up unchanged.
+	template<typename T>
+	class product_tree
+	{
+	public:
+		template<typename Iter>
+		product_tree(Iter begin, Iter end, unsigned threads = 0)
+		{
+			_levels.push_back(std::vector<T>(begin, end));
+			if (_levels[0].empty())
+			{
+				throw std::runtime_error("num::product_tree - no values.");
+			}
+			while (_levels.back().size() > 1)
+			{
+				const std::vector<T>& below = _levels.back();
+				std::vector<T> level((below.size() + 1) / 2);
+				parallel_for_chunks<size_t>(0, level.size(), threads,
+					[&below, &level](size_t first, size_t last, unsigned)
+					{
+						for (size_t i = first; i < last; ++i)
+						{
+							level[i] = 2 * i + 1 < below.size() ? below[2 * i] * below[2 * i + 1] : below[2 * i];
+						}
+					});
+				_levels.push_back(level);
+			}
+		}
+
+		const T& product() const { return _levels.back()[0]; }
+		size_t height() const { return _levels.size(); }
+		const std::vector<T>& level(size_t i) const { return _levels[i]; }
+
+	private:
+		std::vector<std::vector<T> > _levels;
+	};
+
+	// gcd(x_i, x_1 * ... * x_n / x_i) for every x_i in [begin, end),
+	//	written to out in order.  the values must be positive.
+	template<typename Iter, typename Container>
+	// requires Integer(value_type(Iter))
+	void batch_gcd(Iter begin, Iter end, std::back_insert_iterator<Container> out, unsigned threads = 0)
+	{
+		typedef typename std::iterator_traits<Iter>::value_type T;
+		if (begin == end) return;
+		for (Iter i = begin; i != end; ++i)
+		{
+			if (!(T(0) < *i))
+			{
+				throw std::runtime_error("num::batch_gcd - values must be positive.");
+			}
+		}
+
+		product_tree<T> tree(begin, end, threads);
+
+		// walk down: each node becomes (its parent mod node^2)
+		std::vector<T> remainders(1, tree.product());
+		for (size_t h = tree.height() - 1; h-- > 0; )
+		{
+			const std::vector<T>& nodes = tree.level(h);
+			std::vector<T> next(nodes.size());
+			parallel_for_chunks<size_t>(0, nodes.size(), threads,
+				[&nodes, &next, &remainders](size_t first, size_t last, unsigned)
+				{
+					for (size_t i = first; i < last; ++i)
+					{
+						next[i] = remainders[i / 2] % (nodes[i] * nodes[i]);
+					}
+				});
+			remainders.swap(next);
+		}
+
+		// (P mod x^2) / x == (P/x) mod x
+		const std::vector<T>& leaves = tree.level(0);
+		std::vector<T> result(leaves.size());
+		parallel_for_chunks<size_t>(0, leaves.size(), threads,
+			[&leaves, &remainders, &result](size_t first, size_t last, unsigned)
+			{
+				for (size_t i = first; i < last; ++i)
+				{
+					result[i] = gcd(T(remainders[i] / leaves[i]), leaves[i]);
+				}
+			});
+		for (size_t i = 0; i < result.size(); ++i) out++ = result[i];
+	}
+};
+
+#endif // BATCH_GCD_H
@@ -0,0 +1,963 @@
+/*
+ *  big_integer.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * An arbitrary precision Integer: a sign and a magnitude held as 32 bit
+ *	limbs, least significant first, with no leading zero limbs (zero has
+ *	no limbs and is never negative).  Division truncates toward zero and
+ *	>> rounds toward minus infinity, as for the native types, so every
+ *	template in the library that requires Integer(T) works unchanged.
+ *
+ *	Multiplication moves from schoolbook to Karatsuba to Toom-3 to a
+ *	number theoretic transform (three primes, recombined by the Chinese
+ *	remainder theorem) as the operands grow.  Division is Knuth's
+ *	algorithm D, with Burnikel-Ziegler recursive division on top of it
+ *	for long divisors, so division costs a few multiplications.  Decimal
+ *	conversion splits on powers of 10^9 for the same reason.
+ */
+
+#ifndef BIG_INTEGER_H
+#define BIG_INTEGER_H
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+#include <cmath>
+#include <cctype>
+#include <cstddef>
+#include <climits>
+#include <stdint.h>
+
+#include "gcd.h"
+
+namespace num
+{
+	namespace detail
+	{
+		typedef std::vector<uint32_t> limb_vector;
+
+		// operand sizes, in limbs, where each multiplication algorithm
+		//	starts to win over the previous one
+		const size_t karatsuba_threshold = 32;
+		const size_t toom3_threshold = 600;
+		const size_t ntt_threshold = 2000;
+		// divisor size where Burnikel-Ziegler starts to win over Knuth,
+		//	and the quotient size below which it is not worth splitting
+		const size_t burnikel_ziegler_threshold = 80;
+		const size_t burnikel_ziegler_offset = 40;
+
+		inline void trim(limb_vector& a)
+		{
+			while (!a.empty() && a.back() == 0) a.pop_back();
+		}
+
+		inline int compare_magnitudes(const limb_vector& a, const limb_vector& b)
+		{
+			if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+			for (size_t i = a.size(); i-- > 0; )
+			{
+				if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+			}
+			return 0;
+		}
+
+		inline limb_vector add_magnitudes(const uint32_t* a, size_t an, const uint32_t* b, size_t bn)
+		{
+			if (an < bn) { std::swap(a, b); std::swap(an, bn); }
+			limb_vector r(an + 1);
+			uint64_t carry = 0;
+			for (size_t i = 0; i < an; ++i)
+			{
+				carry += (uint64_t)a[i] + (i < bn ? b[i] : 0);
+				r[i] = (uint32_t)carry;
+				carry >>= 32;
+			}
+			r[an] = (uint32_t)carry;
+			trim(r);
+			return r;
+		}
+
+		// a - b for a >= b
+		inline limb_vector subtract_magnitudes(const limb_vector& a, const limb_vector& b)
+		{
+			limb_vector r(a.size());
+			int64_t borrow = 0;
+			for (size_t i = 0; i < a.size(); ++i)
+			{
+				int64_t t = (int64_t)a[i] - (i < b.size() ? b[i] : 0) - borrow;
+				borrow = t < 0;
+				r[i] = (uint32_t)(t + (borrow << 32));
+			}
+			trim(r);
+			return r;
+		}
+
+		// r += b * 2^(32 shift); r must be long enough for the result
+		inline void add_shifted(limb_vector& r, const limb_vector& b, size_t shift)
+		{
+			uint64_t carry = 0;
+			size_t i = 0;
+			for (; i < b.size(); ++i)
+			{
+				carry += (uint64_t)r[i + shift] + b[i];
+				r[i + shift] = (uint32_t)carry;
+				carry >>= 32;
+			}
+			for (i += shift; carry != 0; ++i)
+			{
+				carry += r[i];
+				r[i] = (uint32_t)carry;
+				carry >>= 32;
+			}
+		}
+
+		// r -= b, for r >= b
+		inline void subtract_in_place(limb_vector& r, const limb_vector& b)
+		{
+			int64_t borrow = 0;
+			size_t i = 0;
+			for (; i < b.size(); ++i)
+			{
+				int64_t t = (int64_t)r[i] - b[i] - borrow;
+				borrow = t < 0;
+				r[i] = (uint32_t)(t + (borrow << 32));
+			}
+			for (; borrow != 0; ++i)
+			{
+				borrow = r[i] == 0;
+				--r[i];
+			}
+			trim(r);
+		}
+
+		inline limb_vector multiply_schoolbook(const uint32_t* a, size_t an, const uint32_t* b, size_t bn)
+		{
+			limb_vector r(an + bn, 0);
+			for (size_t i = 0; i < an; ++i)
+			{
+				const uint64_t ai = a[i];
+				if (ai == 0) continue;
+				uint64_t carry = 0;
+				for (size_t j = 0; j < bn; ++j)
+				{
+					carry += ai * b[j] + r[i + j];
+					r[i + j] = (uint32_t)carry;
+					carry >>= 32;
+				}
+				r[i + bn] = (uint32_t)carry;
+			}
+			trim(r);
+			return r;
+		}
+
+		inline limb_vector multiply_magnitudes(const uint32_t* a, size_t an, const uint32_t* b, size_t bn);
+		inline limb_vector multiply_toom3(const uint32_t* a, size_t an, const uint32_t* b, size_t bn);
+
+		// a0 b0 + ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) x + a1 b1 x^2, for
+		//	an >= bn > an/2
+		inline limb_vector multiply_karatsuba(const uint32_t* a, size_t an, const uint32_t* b, size_t bn)
+		{
+			const size_t h = (an + 1) / 2;
+			limb_vector z0 = multiply_magnitudes(a, h, b, h);
+			limb_vector z2 = multiply_magnitudes(a + h, an - h, b + h, bn - h);
+			limb_vector sa = add_magnitudes(a, h, a + h, an - h);
+			limb_vector sb = add_magnitudes(b, h, b + h, bn - h);
+			limb_vector z1 = multiply_magnitudes(sa.empty() ? 0 : &sa[0], sa.size(), sb.empty() ? 0 : &sb[0], sb.size());
+			subtract_in_place(z1, z0);
+			subtract_in_place(z1, z2);
+
+			limb_vector r(an + bn + 1, 0);
+			add_shifted(r, z0, 0);
+			add_shifted(r, z1, h);
+			add_shifted(r, z2, 2 * h);
+			trim(r);
+			return r;
+		}
+
+#ifdef __SIZEOF_INT128__
+		// transforms modulo a prime P = c 2^k + 1 with primitive root G
+		template<uint32_t P, uint32_t G>
+		struct ntt_prime
+		{
+			static uint32_t pow(uint32_t a, uint64_t e)
+			{
+				uint64_t r = 1, x = a;
+				for (; e != 0; e >>= 1)
+				{
+					if (e & 1) r = r * x % P;
+					x = x * x % P;
+				}
+				return (uint32_t)r;
+			}
+
+			static void transform(std::vector<uint32_t>& a, bool inverse)
+			{
+				const size_t n = a.size();
+				for (size_t i = 1, j = 0; i < n; ++i)
+				{
+					size_t bit = n >> 1;
+					for (; j & bit; bit >>= 1) j ^= bit;
+					j ^= bit;
+					if (i < j) std::swap(a[i], a[j]);
+				}
+				// twiddles with Shoup's precomputed quotients: y w mod P is then
+				//	y w - floor(y w' / 2^32) P, in [0, 2P), with no division
+				std::vector<uint32_t> w, ws;
+				for (size_t len = 2; len <= n; len <<= 1)
+				{
+					const size_t half = len / 2;
+					uint32_t root = pow(G, (P - 1) / len);
+					if (inverse) root = pow(root, P - 2);
+					w.resize(half);
+					ws.resize(half);
+					w[0] = 1;
+					for (size_t j = 1; j < half; ++j) w[j] = (uint32_t)((uint64_t)w[j - 1] * root % P);
+					for (size_t j = 0; j < half; ++j) ws[j] = (uint32_t)(((uint64_t)w[j] << 32) / P);
+					for (size_t i = 0; i < n; i += len)
+					{
+						uint32_t* x = &a[i];
+						uint32_t* y = &a[i + half];
+						for (size_t j = 0; j < half; ++j)
+						{
+							const uint32_t u = x[j];
+							const uint32_t q = (uint32_t)(((uint64_t)y[j] * ws[j]) >> 32);
+							uint32_t v = y[j] * w[j] - q * P;
+							if (v >= P) v -= P;
+							x[j] = u + v >= P ? u + v - P : u + v;
+							y[j] = u >= v ? u - v : u + P - v;
+						}
+					}
+				}
+				if (inverse)
+				{
+					const uint64_t scale = pow((uint32_t)n, P - 2);
+					for (size_t i = 0; i < n; ++i) a[i] = (uint32_t)(a[i] * scale % P);
+				}
+			}
+
+			// the cyclic convolution of a and b modulo P, length n
+			static std::vector<uint32_t> convolve(const uint32_t* a, size_t an, const uint32_t* b, size_t bn, size_t n)
+			{
+				std::vector<uint32_t> fa(n, 0);
+				for (size_t i = 0; i < an; ++i) fa[i] = a[i] % P;
+				transform(fa, false);
+				if (a == b && an == bn)
+				{	// squaring needs one forward transform
+					for (size_t i = 0; i < n; ++i) fa[i] = (uint32_t)((uint64_t)fa[i] * fa[i] % P);
+				}
+				else
+				{
+					std::vector<uint32_t> fb(n, 0);
+					for (size_t i = 0; i < bn; ++i) fb[i] = b[i] % P;
+					transform(fb, false);
+					for (size_t i = 0; i < n; ++i) fa[i] = (uint32_t)((uint64_t)fa[i] * fb[i] % P);
+				}
+				transform(fa, true);
+				return fa;
+			}
+		};
+
+		typedef ntt_prime<998244353u, 3> ntt_prime1;	// 119 * 2^23 + 1
+		typedef ntt_prime<167772161u, 3> ntt_prime2;	// 5 * 2^25 + 1
+		typedef ntt_prime<469762049u, 3> ntt_prime3;	// 7 * 2^26 + 1
+
+		// the longest transform all three primes support, and the most
+		//	terms a coefficient may sum before it outgrows their product
+		const size_t ntt_max_length = (size_t)1 << 23;
+		const size_t ntt_max_terms = (size_t)1 << 21;
+
+		inline bool ntt_fits(size_t an, size_t bn)
+		{
+			return an + bn <= ntt_max_length && std::min(an, bn) <= ntt_max_terms;
+		}
+
+		inline limb_vector multiply_ntt(const uint32_t* a, size_t an, const uint32_t* b, size_t bn)
+		{
+			size_t n = 1;
+			while (n < an + bn) n <<= 1;
+			std::vector<uint32_t> r1 = ntt_prime1::convolve(a, an, b, bn, n);
+			std::vector<uint32_t> r2 = ntt_prime2::convolve(a, an, b, bn, n);
+			std::vector<uint32_t> r3 = ntt_prime3::convolve(a, an, b, bn, n);
+
+			// Garner: c = v1 + v2 m1 + v3 m1 m2
+			const uint64_t m1 = 998244353u, m2 = 167772161u, m3 = 469762049u;
+			const uint64_t m1_inv_m2 = ntt_prime2::pow((uint32_t)(m1 % m2), m2 - 2);
+			const uint64_t m1_inv_m3 = ntt_prime3::pow((uint32_t)(m1 % m3), m3 - 2);
+			const uint64_t m2_inv_m3 = ntt_prime3::pow((uint32_t)(m2 % m3), m3 - 2);
+			const unsigned __int128 m12 = (unsigned __int128)m1 * m2;
+
+			limb_vector r(an + bn, 0);
+			unsigned __int128 carry = 0;
+			for (size_t i = 0; i < an + bn; ++i)
+			{
+				const uint64_t v1 = r1[i];
+				const uint64_t v2 = (r2[i] + m2 - v1 % m2) % m2 * m1_inv_m2 % m2;
+				uint64_t v3 = (r3[i] + m3 - v1 % m3) % m3 * m1_inv_m3 % m3;
+				v3 = (v3 + m3 - v2 % m3) % m3 * m2_inv_m3 % m3;
+				carry += v1 + (unsigned __int128)v2 * m1 + v3 * m12;
+				r[i] = (uint32_t)carry;
+				carry >>= 32;
+			}
+			trim(r);
+			return r;
+		}
+#else
+		inline bool ntt_fits(size_t, size_t) { return false; }
+		inline limb_vector multiply_ntt(const uint32_t* a, size_t an, const uint32_t* b, size_t bn)
+		{
+			return multiply_toom3(a, an, b, bn);
+		}
+#endif
+
+		// picks the algorithm by the size of the smaller operand
+		inline limb_vector multiply_magnitudes(const uint32_t* a, size_t an, const uint32_t* b, size_t bn)
+		{
+			while (an > 0 && a[an - 1] == 0) --an;
+			while (bn > 0 && b[bn - 1] == 0) --bn;
+			if (an < bn) { std::swap(a, b); std::swap(an, bn); }
+			if (bn == 0) return limb_vector();
+			if (bn < karatsuba_threshold) return multiply_schoolbook(a, an, b, bn);
+			if (bn >= ntt_threshold && ntt_fits(an, bn)) return multiply_ntt(a, an, b, bn);
+			if (an >= 2 * bn)
+			{	// unbalanced: multiply b by bn-limb slices of a
+				limb_vector r(an + bn + 1, 0);
+				for (size_t offset = 0; offset < an; offset += bn)
+				{
+					add_shifted(r, multiply_magnitudes(a + offset, std::min(bn, an - offset), b, bn), offset);
+				}
+				trim(r);
+				return r;
+			}
+			if (bn < toom3_threshold) return multiply_karatsuba(a, an, b, bn);
+			return multiply_toom3(a, an, b, bn);
+		}
+
+		inline limb_vector multiply_magnitudes(const limb_vector& a, const limb_vector& b)
+		{
+			if (a.empty() || b.empty()) return limb_vector();
+			return multiply_magnitudes(&a[0], a.size(), &b[0], b.size());
+		}
+
+		inline int leading_zeros(uint32_t x)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_clz(x);
+#else
+			int n = 0;
+			for (; (x & 0x80000000u) == 0; x <<= 1) ++n;
+			return n;
+#endif
+		}
+
+		// quotient and remainder of a by the single limb d
+		inline uint32_t divide_by_limb(limb_vector& a, uint32_t d)
+		{
+			uint64_t r = 0;
+			for (size_t i = a.size(); i-- > 0; )
+			{
+				uint64_t t = (r << 32) | a[i];
+				a[i] = (uint32_t)(t / d);
+				r = t % d;
+			}
+			trim(a);
+			return (uint32_t)r;
+		}
+
+		// Knuth's algorithm D (as in Hacker's Delight), b at least two limbs
+		inline void divide_knuth(const limb_vector& a, const limb_vector& b, limb_vector& q, limb_vector& r)
+		{
+			const size_t n = b.size(), m = a.size() - n;
+			const int s = leading_zeros(b.back());
+			limb_vector bn(n), an(a.size() + 1);
+			for (size_t i = n; i-- > 0; )
+			{
+				bn[i] = (b[i] << s) | (s && i > 0 ? b[i - 1] >> (32 - s) : 0);
+			}
+			an[a.size()] = s ? a.back() >> (32 - s) : 0;
+			for (size_t i = a.size(); i-- > 0; )
+			{
+				an[i] = (a[i] << s) | (s && i > 0 ? a[i - 1] >> (32 - s) : 0);
+			}
+
+			const uint64_t base = (uint64_t)1 << 32;
+			q.assign(m + 1, 0);
+			for (size_t j = m + 1; j-- > 0; )
+			{
+				const uint64_t top = ((uint64_t)an[j + n] << 32) | an[j + n - 1];
+				uint64_t qhat = top / bn[n - 1];
+				uint64_t rhat = top % bn[n - 1];
+				while (qhat >= base || qhat * bn[n - 2] > ((rhat << 32) | an[j + n - 2]))
+				{
+					--qhat;
+					rhat += bn[n - 1];
+					if (rhat >= base) break;
+				}
+
+				int64_t k = 0, t;
+				for (size_t i = 0; i < n; ++i)
+				{
+					const uint64_t p = qhat * bn[i];
+					t = (int64_t)an[i + j] - k - (int64_t)(p & 0xFFFFFFFFu);
+					an[i + j] = (uint32_t)t;
+					k = (int64_t)(p >> 32) - (t >> 32);
+				}
+				t = (int64_t)an[j + n] - k;
+				an[j + n] = (uint32_t)t;
+
+				if (t < 0)
+				{	// qhat was one too large; add b back
+					--qhat;
+					uint64_t carry = 0;
+					for (size_t i = 0; i < n; ++i)
+					{
+						carry += (uint64_t)an[i + j] + bn[i];
+						an[i + j] = (uint32_t)carry;
+						carry >>= 32;
+					}
+					an[j + n] += (uint32_t)carry;
+				}
+				q[j] = (uint32_t)qhat;
+			}
+
+			r.resize(n);
+			for (size_t i = 0; i < n; ++i)
+			{
+				r[i] = (an[i] >> s) | (s ? (uint32_t)((uint64_t)an[i + 1] << (32 - s)) : 0);
+			}
+			trim(q);
+			trim(r);
+		}
+	}
+
+	class big_integer
+	{
+	public:
+		typedef detail::limb_vector limb_vector;
+
+		big_integer() : _negative(false) {}
+
+		template<typename I>
+		big_integer(I value, typename std::enable_if<std::is_integral<I>::value
+					 && !std::is_same<I, bool>::value>::type* = 0) : _negative(value < I(0))
+		{
+			typedef typename std::make_unsigned<I>::type U;
+			U m = _negative ? U(U(0) - U(value)) : U(value);
+			for (; m != 0; m = sizeof(U) > 4 ? U(m >> 16 >> 16) : U(0))
+			{
+				_limbs.push_back((uint32_t)m);
+			}
+		}
+
+		// decimal digits with an optional sign
+		explicit big_integer(const std::string& s) : _negative(false) { parse(s); }
+		explicit big_integer(const char* s) : _negative(false) { parse(s); }
+
+		// the low bits, as the native types convert (two's complement)
+		template<typename I, typename = typename std::enable_if<std::is_integral<I>::value>::type>
+		explicit operator I() const
+		{
+			typedef typename std::make_unsigned<I>::type U;
+			U r = 0;
+			for (size_t i = std::min(_limbs.size(), (sizeof(U) + 3) / 4); i-- > 0; )
+			{
+				r = sizeof(U) > 4 ? U(U(r << 16 << 16) | _limbs[i]) : U(_limbs[i]);
+			}
+			return I(_negative ? U(U(0) - r) : r);
+		}
+
+		explicit operator double() const
+		{
+			double r = 0;
+			const size_t top = _limbs.size() > 3 ? _limbs.size() - 3 : 0;
+			for (size_t i = _limbs.size(); i-- > top; ) r = r * 4294967296.0 + _limbs[i];
+			r = std::ldexp(r, (int)(32 * top));
+			return _negative ? -r : r;
+		}
+
+		std::string to_string() const
+		{
+			std::string s = _negative ? "-" : "";
+			std::vector<big_integer> powers;
+			magnitude().write_decimal(s, 0, powers);
+			return s;
+		}
+
+		bool is_zero() const { return _limbs.empty(); }
+		int sign() const { return _limbs.empty() ? 0 : (_negative ? -1 : 1); }
+		const limb_vector& limbs() const { return _limbs; }
+
+		// bits in the magnitude
+		size_t bit_length() const
+		{
+			return _limbs.empty() ? 0 : 32 * _limbs.size() - detail::leading_zeros(_limbs.back());
+		}
+
+		big_integer operator-() const
+		{
+			big_integer r(*this);
+			if (!r.is_zero()) r._negative = !r._negative;
+			return r;
+		}
+
+		big_integer& operator+=(const big_integer& b)
+		{
+			if (_negative == b._negative)
+			{
+				_limbs = detail::add_magnitudes(data(), _limbs.size(), b.data(), b._limbs.size());
+			}
+			else if (detail::compare_magnitudes(_limbs, b._limbs) >= 0)
+			{
+				_limbs = detail::subtract_magnitudes(_limbs, b._limbs);
+			}
+			else
+			{
+				_limbs = detail::subtract_magnitudes(b._limbs, _limbs);
+				_negative = b._negative;
+			}
+			return normalize();
+		}
+
+		big_integer& operator-=(const big_integer& b)
+		{
+			if (this == &b) return *this = big_integer();
+			_negative = !_negative;
+			*this += b;
+			_negative = !_negative;
+			return normalize();
+		}
+
+		big_integer& operator*=(const big_integer& b)
+		{
+			_limbs = detail::multiply_magnitudes(_limbs, b._limbs);
+			_negative = _negative != b._negative;
+			return normalize();
+		}
+
+		big_integer& operator/=(const big_integer& b)
+		{
+			big_integer q, r;
+			divide(*this, b, q, r);
+			return *this = q;
+		}
+
+		big_integer& operator%=(const big_integer& b)
+		{
+			big_integer q, r;
+			divide(*this, b, q, r);
+			return *this = r;
+		}
+
+		big_integer& operator<<=(int k)
+		{
+			if (k < 0) return *this >>= -k;
+			if (is_zero() || k == 0) return *this;
+			const size_t limbs = (size_t)k / 32;
+			const int bits = k % 32;
+			limb_vector r(_limbs.size() + limbs + 1, 0);
+			for (size_t i = 0; i < _limbs.size(); ++i)
+			{
+				const uint64_t v = (uint64_t)_limbs[i] << bits;
+				r[i + limbs] |= (uint32_t)v;
+				r[i + limbs + 1] = (uint32_t)(v >> 32);
+			}
+			_limbs.swap(r);
+			return normalize();
+		}
+
+		// floor(*this / 2^k), like >> on a two's complement native type
+		big_integer& operator>>=(int k)
+		{
+			if (k < 0) return *this <<= -k;
+			const size_t limbs = (size_t)k / 32;
+			const int bits = k % 32;
+			if (limbs >= _limbs.size())
+			{
+				*this = _negative ? big_integer(-1) : big_integer();
+				return *this;
+			}
+			bool inexact = false;
+			for (size_t i = 0; i < limbs; ++i) inexact = inexact || _limbs[i] != 0;
+			inexact = inexact || (bits && (_limbs[limbs] & ((1u << bits) - 1)) != 0);
+
+			limb_vector r(_limbs.size() - limbs);
+			for (size_t i = 0; i < r.size(); ++i)
+			{
+				const uint64_t v = _limbs[i + limbs] | (i + limbs + 1 < _limbs.size() ? (uint64_t)_limbs[i + limbs + 1] << 32 : 0);
+				r[i] = (uint32_t)(v >> bits);
+			}
+			const bool negative = _negative;
+			_limbs.swap(r);
+			normalize();
+			if (negative && inexact)
+			{	// round toward minus infinity
+				_negative = true;
+				*this -= big_integer(1);
+			}
+			return normalize();
+		}
+
+		big_integer& operator++() { return *this += big_integer(1); }
+		big_integer& operator--() { return *this -= big_integer(1); }
+		big_integer operator++(int) { big_integer t(*this); ++*this; return t; }
+		big_integer operator--(int) { big_integer t(*this); --*this; return t; }
+
+		friend big_integer operator+(big_integer a, const big_integer& b) { return a += b; }
+		friend big_integer operator-(big_integer a, const big_integer& b) { return a -= b; }
+		friend big_integer operator*(big_integer a, const big_integer& b) { return a *= b; }
+		friend big_integer operator/(big_integer a, const big_integer& b) { return a /= b; }
+		friend big_integer operator%(big_integer a, const big_integer& b) { return a %= b; }
+		friend big_integer operator<<(big_integer a, int k) { return a <<= k; }
+		friend big_integer operator>>(big_integer a, int k) { return a >>= k; }
+
+		friend bool operator==(const big_integer& a, const big_integer& b)
+		{ return a._negative == b._negative && a._limbs == b._limbs; }
+		friend bool operator!=(const big_integer& a, const big_integer& b) { return !(a == b); }
+		friend bool operator<(const big_integer& a, const big_integer& b)
+		{
+			if (a._negative != b._negative) return a._negative;
+			int c = detail::compare_magnitudes(a._limbs, b._limbs);
+			return a._negative ? c > 0 : c < 0;
+		}
+		friend bool operator>(const big_integer& a, const big_integer& b) { return b < a; }
+		friend bool operator<=(const big_integer& a, const big_integer& b) { return !(b < a); }
+		friend bool operator>=(const big_integer& a, const big_integer& b) { return !(a < b); }
+
+		friend std::ostream& operator<<(std::ostream& out, const big_integer& a)
+		{
+			return out << a.to_string();
+		}
+
+		friend std::istream& operator>>(std::istream& in, big_integer& a)
+		{
+			std::string s;
+			if (in >> s) a = big_integer(s);
+			return in;
+		}
+
+		// q = a/b truncated toward zero and r = a - q*b
+		static void divide(const big_integer& a, const big_integer& b, big_integer& q, big_integer& r)
+		{
+			if (b.is_zero())
+			{
+				throw std::runtime_error("num::big_integer - division by zero.");
+			}
+			big_integer quotient, remainder;
+			divide_magnitudes(a.magnitude(), b.magnitude(), quotient, remainder);
+			quotient._negative = a._negative != b._negative;
+			remainder._negative = a._negative;
+			q = quotient.normalize();
+			r = remainder.normalize();
+		}
+
+	private:
+		const uint32_t* data() const { return _limbs.empty() ? 0 : &_limbs[0]; }
+
+		big_integer& normalize()
+		{
+			detail::trim(_limbs);
+			if (_limbs.empty()) _negative = false;
+			return *this;
+		}
+
+		big_integer magnitude() const
+		{
+			big_integer r(*this);
+			r._negative = false;
+			return r;
+		}
+
+		static big_integer from_limbs(const uint32_t* first, const uint32_t* last)
+		{
+			big_integer r;
+			r._limbs.assign(first, last);
+			return r.normalize();
+		}
+
+		// limbs [lo, hi) of a nonnegative value, as a value
+		big_integer slice(size_t lo, size_t hi) const
+		{
+			lo = std::min(lo, _limbs.size());
+			hi = std::min(hi, _limbs.size());
+			return lo < hi ? from_limbs(&_limbs[0] + lo, &_limbs[0] + hi) : big_integer();
+		}
+
+		// both nonnegative
+		static void divide_magnitudes(const big_integer& a, const big_integer& b, big_integer& q, big_integer& r)
+		{
+			if (detail::compare_magnitudes(a._limbs, b._limbs) < 0)
+			{
+				q = big_integer();
+				r = a;
+			}
+			else if (b._limbs.size() == 1)
+			{
+				q = a;
+				r = big_integer(detail::divide_by_limb(q._limbs, b._limbs[0]));
+			}
+			else if (b._limbs.size() >= detail::burnikel_ziegler_threshold
+					 && a._limbs.size() - b._limbs.size() >= detail::burnikel_ziegler_offset)
+			{
+				divide_burnikel_ziegler(a, b, q, r);
+			}
+			else
+			{
+				q = big_integer();
+				r = big_integer();
+				detail::divide_knuth(a._limbs, b._limbs, q._limbs, r._limbs);
+			}
+		}
+
+		// Burnikel and Ziegler, "Fast Recursive Division" (1998).  b is
+		//	padded to j*m limbs (m a power of two) and shifted so its top
+		//	bit is set, then a is divided one n-limb block at a time, each
+		//	step a 2n-by-n division done recursively.
+		static void divide_burnikel_ziegler(const big_integer& a, const big_integer& b, big_integer& q, big_integer& r)
+		{
+			const size_t s = b._limbs.size();
+			size_t m = 1;
+			while (m * detail::burnikel_ziegler_threshold <= s) m <<= 1;
+			const size_t j = (s + m - 1) / m, n = j * m;
+			const int sigma = (int)(32 * n - b.bit_length());
+			const big_integer bs = b << sigma, as = a << sigma;
+
+			size_t t = (as.bit_length() + 32 * n) / (32 * n);
+			if (t < 2) t = 2;
+
+			big_integer z = as.slice((t - 2) * n, t * n);
+			q = big_integer();
+			big_integer qi, ri;
+			for (size_t i = t - 2; i > 0; --i)
+			{
+				divide_2n_by_n(z, bs, qi, ri);
+				z = (ri << (int)(32 * n)) + as.slice((i - 1) * n, i * n);
+				q += qi << (int)(32 * i * n);
+			}
+			divide_2n_by_n(z, bs, qi, ri);
+			q += qi;
+			r = ri >> sigma;
+		}
+
+		// a < b * 2^(32n) where b has n limbs
+		static void divide_2n_by_n(const big_integer& a, const big_integer& b, big_integer& q, big_integer& r)
+		{
+			const size_t n = b._limbs.size();
+			if ((n & 1) || n < detail::burnikel_ziegler_threshold)
+			{
+				q = big_integer();
+				r = big_integer();
+				if (detail::compare_magnitudes(a._limbs, b._limbs) < 0) r = a;
+				else detail::divide_knuth(a._limbs, b._limbs, q._limbs, r._limbs);
+				return;
+			}
+			const size_t half = n / 2;
+			big_integer q1, r1, q2;
+			divide_3n_by_2n(a.slice(half, a._limbs.size()), b, q1, r1);
+			divide_3n_by_2n((r1 << (int)(32 * half)) + a.slice(0, half), b, q2, r);
+			q = (q1 << (int)(32 * half)) + q2;
+		}
+
+		// a < b * 2^(32n) where b has 2n limbs
+		static void divide_3n_by_2n(const big_integer& a, const big_integer& b, big_integer& q, big_integer& r)
+		{
+			const size_t n = b._limbs.size() / 2;
+			const int shift = (int)(32 * n);
+			const big_integer a12 = a.slice(n, a._limbs.size());
+			const big_integer b1 = b.slice(n, 2 * n), b2 = b.slice(0, n);
+
+			big_integer r1, d;
+			if (a.slice(2 * n, a._limbs.size()) < b1)
+			{
+				divide_2n_by_n(a12, b1, q, r1);
+				d = q * b2;
+			}
+			else
+			{	// q = 2^(32n) - 1
+				q = (big_integer(1) << shift) - big_integer(1);
+				r1 = a12 - (b1 << shift) + b1;
+				d = (b2 << shift) - b2;
+			}
+			r = (r1 << shift) + a.slice(0, n);
+			while (r < d)
+			{
+				r += b;
+				--q;
+			}
+			r -= d;
+		}
+
+		// the decimal digits of a nonnegative value, at least width of them
+		//	(zero padded; no padding when width is 0).  splits on
+		//	powers[k] = 10^(9 * 2^k) so the divisions stay balanced.
+		void write_decimal(std::string& s, size_t width, std::vector<big_integer>& powers) const
+		{
+			if (_limbs.size() < 32)
+			{
+				std::string digits;
+				limb_vector v(_limbs);
+				while (!v.empty())
+				{
+					uint32_t chunk = detail::divide_by_limb(v, 1000000000u);
+					for (int i = 0; i < 9 && (!v.empty() || chunk != 0); ++i)
+					{
+						digits.push_back(char('0' + chunk % 10));
+						chunk /= 10;
+					}
+				}
+				if (digits.empty() && width == 0) digits = "0";
+				if (digits.size() < width) digits.append(width - digits.size(), '0');
+				s.append(digits.rbegin(), digits.rend());
+				return;
+			}
+			if (powers.empty()) powers.push_back(big_integer(1000000000u));
+			size_t k = 0;
+			while (true)
+			{
+				if (k + 1 == powers.size()) powers.push_back(powers[k] * powers[k]);
+				if (2 * powers[k + 1]._limbs.size() > _limbs.size() + 1) break;
+				++k;
+			}
+			const size_t low_digits = (size_t)9 << k;
+			big_integer high, low;
+			divide_magnitudes(*this, powers[k], high, low);
+			high.write_decimal(s, width > low_digits ? width - low_digits : 0, powers);
+			low.write_decimal(s, low_digits, powers);
+		}
+
+		void parse(const std::string& text)
+		{
+			size_t i = 0;
+			while (i < text.size() && std::isspace((unsigned char)text[i])) ++i;
+			bool negative = false;
+			if (i < text.size() && (text[i] == '+' || text[i] == '-')) negative = text[i++] == '-';
+			if (i == text.size())
+			{
+				throw std::runtime_error("num::big_integer - no digits.");
+			}
+			for (size_t j = i; j < text.size(); ++j)
+			{
+				if (text[j] < '0' || text[j] > '9')
+				{
+					throw std::runtime_error("num::big_integer - invalid digit.");
+				}
+			}
+			std::vector<big_integer> powers;
+			*this = read_decimal(text.data() + i, text.size() - i, powers);
+			_negative = negative;
+			normalize();
+		}
+
+		// the value of a run of decimal digits; the mirror of write_decimal
+		static big_integer read_decimal(const char* digits, size_t n, std::vector<big_integer>& powers)
+		{
+			if (n <= 9 * 32)
+			{
+				big_integer r;
+				for (size_t i = 0; i < n; )
+				{
+					uint32_t chunk = 0, scale = 1;
+					for (size_t e = std::min(n, i + 9); i < e; ++i)
+					{
+						chunk = chunk * 10 + uint32_t(digits[i] - '0');
+						scale *= 10;
+					}
+					r._limbs.push_back(0);
+					uint64_t carry = chunk;
+					for (size_t j = 0; j < r._limbs.size(); ++j)
+					{
+						carry += (uint64_t)r._limbs[j] * scale;
+						r._limbs[j] = (uint32_t)carry;
+						carry >>= 32;
+					}
+				}
+				return r.normalize();
+			}
+			if (powers.empty()) powers.push_back(big_integer(1000000000u));
+			size_t k = 0;
+			while (((size_t)9 << (k + 1)) < n)
+			{
+				++k;
+				if (k == powers.size()) powers.push_back(powers[k - 1] * powers[k - 1]);
+			}
+			const size_t low_digits = (size_t)9 << k;
+			big_integer r = read_decimal(digits, n - low_digits, powers) * powers[k];
+			return r += read_decimal(digits + n - low_digits, low_digits, powers);
+		}
+
+		limb_vector _limbs;
+		bool _negative;
+
+		friend limb_vector detail::multiply_toom3(const uint32_t*, size_t, const uint32_t*, size_t);
+	};
+
+	namespace detail
+	{
+		// Toom-3 (Bodrato's evaluation and interpolation sequence): split
+		//	each operand in three, multiply the pieces' combinations at
+		//	0, 1, -1, -2 and infinity, and interpolate the five products.
+		inline limb_vector multiply_toom3(const uint32_t* a, size_t an, const uint32_t* b, size_t bn)
+		{
+			const size_t k = (std::max(an, bn) + 2) / 3;
+			const int shift = (int)(32 * k);
+			big_integer a0 = big_integer::from_limbs(a, a + std::min(an, k));
+			big_integer a1 = big_integer::from_limbs(a + std::min(an, k), a + std::min(an, 2 * k));
+			big_integer a2 = big_integer::from_limbs(a + std::min(an, 2 * k), a + an);
+			big_integer b0 = big_integer::from_limbs(b, b + std::min(bn, k));
+			big_integer b1 = big_integer::from_limbs(b + std::min(bn, k), b + std::min(bn, 2 * k));
+			big_integer b2 = big_integer::from_limbs(b + std::min(bn, 2 * k), b + bn);
+
+			big_integer p = a0 + a2, p1 = p + a1, pm1 = p - a1;
+			big_integer pm2 = ((pm1 + a2) << 1) - a0;
+			big_integer q = b0 + b2, q1 = q + b1, qm1 = q - b1;
+			big_integer qm2 = ((qm1 + b2) << 1) - b0;
+
+			big_integer r0 = a0 * b0, r1 = p1 * q1, rm1 = pm1 * qm1, rm2 = pm2 * qm2, rinf = a2 * b2;
+
+			big_integer r3 = (rm2 - r1) / big_integer(3);
+			r1 = (r1 - rm1) >> 1;
+			big_integer r2 = rm1 - r0;
+			r3 = ((r2 - r3) >> 1) + (rinf << 1);
+			r2 += r1 - rinf;
+			r1 -= r3;
+
+			big_integer r = r0 + (r1 << shift) + (r2 << (2 * shift)) + (r3 << (3 * shift)) + (rinf << (4 * shift));
+			return r._limbs;
+		}
+	}
+
+	// bits in the magnitude; found by Lehmer's gcd through argument
+	//	dependent lookup
+	inline int bit_length(const big_integer& x)
+	{
+		return (int)x.bit_length();
+	}
+};
+
+namespace std
+{
+	template<>
+	class numeric_limits<num::big_integer>
+	{
+	public:
+		static const bool is_specialized = true;
+		static const bool is_signed = true;
+		static const bool is_integer = true;
+		static const bool is_exact = true;
+		static const bool is_bounded = false;
+		static const bool is_modulo = false;
+		static const int radix = 2;
+		static const int digits = INT_MAX;
+		static const int digits10 = INT_MAX;
+		static num::big_integer min() { return num::big_integer(); }
+		static num::big_integer max() { return num::big_integer(); }
+		static num::big_integer lowest() { return num::big_integer(); }
+	};
+}
+
+#endif // BIG_INTEGER_H
@@ -6,9 +6,19 @@
  *  Copyright 2010 __MyCompanyName__. All rights reserved.
  *
  */
+
+#ifndef BINARY_SPLITTING_H
+#define BINARY_SPLITTING_H
+
 #include <cassert>
+#include <cmath>
+#include <thread>
+#include <stdint.h>
+
+#include "integer.h"
+#include "parallel.h"
 
-// this file contains some example implementations of binary splitting that will hopefully lead to 
+// this file contains some example implementations of binary splitting and
 // a generic implementation based on http://www.ginac.de/CLN/binsplit.pdf
 template<typename T>
 //requires Integer(T)
@@ -44,4 +54,206 @@ T rational_factorial(const T& a, const T& b)
 			return rational_factorial(a, (a+b)/2)
 			*rational_factorial((a+b)/2, b);			
 	}
-}
\ No newline at end of file
+}
+
+namespace num
+{
+	// A series S = sum over n of a(n)/b(n) * p(0)...p(n) / (q(0)...q(n))
+	//	with integer a, b, p, q is summed exactly over [n1, n2) as
+	//	P = p(n1)...p(n2-1), Q = q(n1)...q(n2-1), B = b(n1)...b(n2-1) and
+	//	T = B Q S.  halves combine as
+	//		P = Pl Pr, Q = Ql Qr, B = Bl Br, T = Br Qr Tl + Bl Pl Tr
+	//	so the work is a balanced tree of multiplications of numbers of
+	//	similar size, which is where fast multiplication pays off.
+	//
+	// a Series supplies I a(n), b(n), p(n), q(n) for uint64_t n.
+	template<typename I>
+	struct binary_splitting_result
+	{
+		I P, Q, B, T;
+	};
+
+	namespace detail
+	{
+		// below this many terms a subtree is not worth a thread
+		const uint64_t binary_splitting_grain = 256;
+
+		template<typename I, typename Series>
+		binary_splitting_result<I> split_range(const Series& s, uint64_t n1, uint64_t n2, unsigned threads)
+		{
+			binary_splitting_result<I> r;
+			if (n2 - n1 == 1)
+			{
+				r.P = s.p(n1);
+				r.Q = s.q(n1);
+				r.B = s.b(n1);
+				r.T = s.a(n1) * r.P;
+				return r;
+			}
+
+			const uint64_t m = n1 + (n2 - n1) / 2;
+			binary_splitting_result<I> left, right;
+			if (threads > 1 && n2 - n1 >= binary_splitting_grain)
+			{	// the left half on a new thread, the right half here
+				std::thread worker([&]() { left = split_range<I>(s, n1, m, threads / 2); });
+				right = split_range<I>(s, m, n2, threads - threads / 2);
+				worker.join();
+			}
+			else
+			{
+				left = split_range<I>(s, n1, m, 1);
+				right = split_range<I>(s, m, n2, 1);
+			}
+
+			r.T = right.B * right.Q * left.T + left.B * left.P * right.T;
+			r.P = left.P * right.P;
+			r.Q = left.Q * right.Q;
+			r.B = left.B * right.B;
+			return r;
+		}
+
+		// 10^k
+		template<typename I>
+		I power_of_ten(uint64_t k)
+		{
+			return k == 0 ? I(1) : power(I(10), k, mult<I>());
+		}
+
+		// guard digits carried through the constants that combine several series
+		const uint64_t binary_splitting_guard = 10;
+	}
+
+	// P, Q, B and T for terms [n1, n2) of the series, on up to threads
+	//	threads (0 means one per hardware thread)
+	template<typename I, typename Series>
+	// requires Integer(I)
+	binary_splitting_result<I> binary_splitting(const Series& s, uint64_t n1, uint64_t n2, unsigned threads = 0)
+	{
+		assert(n1 < n2);
+		if (threads == 0) threads = hardware_threads();
+		return detail::split_range<I>(s, n1, n2, threads);
+	}
+
+	// floor(scale * S) for the first terms terms of the series
+	template<typename I, typename Series>
+	// requires Integer(I)
+	I series_sum(const Series& s, uint64_t terms, const I& scale, unsigned threads = 0)
+	{
+		binary_splitting_result<I> r = binary_splitting<I>(s, 0, terms, threads);
+		return r.T * scale / (r.B * r.Q);
+	}
+
+	// e = sum 1/n!
+	template<typename I>
+	struct e_series
+	{
+		I a(uint64_t) const { return I(1); }
+		I b(uint64_t) const { return I(1); }
+		I p(uint64_t) const { return I(1); }
+		I q(uint64_t n) const { return n == 0 ? I(1) : I(n); }
+
+		// enough terms that n! > 10^digits
+		static uint64_t terms(uint64_t digits)
+		{
+			uint64_t n = 1;
+			for (double log_factorial = 0; log_factorial <= digits + 1.0; ++n)
+			{
+				log_factorial += std::log10(double(n));
+			}
+			return n;
+		}
+	};
+
+	// arctan(1/x) = sum (-1)^n / ((2n+1) x^(2n+1)), or
+	//	atanh(1/x) = sum 1 / ((2n+1) x^(2n+1)) when hyperbolic
+	template<typename I>
+	struct arctan_series
+	{
+		arctan_series(uint64_t x, bool hyperbolic = false) : _x(x), _hyperbolic(hyperbolic) {}
+
+		I a(uint64_t) const { return I(1); }
+		I b(uint64_t n) const { return I(2 * n + 1); }
+		I p(uint64_t n) const { return n == 0 || _hyperbolic ? I(1) : I(-1); }
+		I q(uint64_t n) const { return n == 0 ? I(_x) : I(_x) * I(_x); }
+
+		uint64_t terms(uint64_t digits) const
+		{
+			return uint64_t((digits + 1) / (2 * std::log10(double(_x)))) + 2;
+		}
+	private:
+		uint64_t _x;
+		bool _hyperbolic;
+	};
+
+	// zeta(3) = 1/64 sum (-1)^n (205n^2 + 250n + 77) (n!)^10 / ((2n+1)!)^5
+	//	(Amdeberhan and Zeilberger), about three digits a term
+	template<typename I>
+	struct zeta3_series
+	{
+		I a(uint64_t n) const { return I(205) * I(n) * I(n) + I(250) * I(n) + I(77); }
+		I b(uint64_t) const { return I(1); }
+		I p(uint64_t n) const
+		{
+			if (n == 0) return I(1);
+			I n2 = I(n) * I(n);
+			return -(n2 * n2 * I(n));
+		}
+		I q(uint64_t n) const
+		{
+			if (n == 0) return I(1);
+			I m(2 * n + 1), m2 = m * m;
+			return I(32) * m2 * m2 * m;
+		}
+
+		static uint64_t terms(uint64_t digits)
+		{
+			return uint64_t((digits + 1) / std::log10(1024.0)) + 2;
+		}
+	};
+
+	// the constants below are floor(c * 10^digits), accurate unless the
+	//	digits past the last are a long run of 9s or 0s
+	template<typename I>
+	// requires Integer(I)
+	I e_digits(uint64_t digits, unsigned threads = 0)
+	{
+		e_series<I> s;
+		return series_sum(s, s.terms(digits), detail::power_of_ten<I>(digits), threads);
+	}
+
+	// Machin: pi = 16 arctan(1/5) - 4 arctan(1/239)
+	template<typename I>
+	// requires Integer(I)
+	I pi_digits(uint64_t digits, unsigned threads = 0)
+	{
+		const uint64_t d = digits + detail::binary_splitting_guard;
+		const I scale = detail::power_of_ten<I>(d);
+		arctan_series<I> s5(5), s239(239);
+		I pi = I(16) * series_sum(s5, s5.terms(d), scale, threads) - I(4) * series_sum(s239, s239.terms(d), scale, threads);
+		return pi / detail::power_of_ten<I>(detail::binary_splitting_guard);
+	}
+
+	// log 2 = 18 atanh(1/26) - 2 atanh(1/4801) + 8 atanh(1/8749)
+	template<typename I>
+	// requires Integer(I)
+	I log2_digits(uint64_t digits, unsigned threads = 0)
+	{
+		const uint64_t d = digits + detail::binary_splitting_guard;
+		const I scale = detail::power_of_ten<I>(d);
+		arctan_series<I> s26(26, true), s4801(4801, true), s8749(8749, true);
+		I log2 = I(18) * series_sum(s26, s26.terms(d), scale, threads)
+			- I(2) * series_sum(s4801, s4801.terms(d), scale, threads)
+			+ I(8) * series_sum(s8749, s8749.terms(d), scale, threads);
+		return log2 / detail::power_of_ten<I>(detail::binary_splitting_guard);
+	}
+
+	template<typename I>
+	// requires Integer(I)
+	I zeta3_digits(uint64_t digits, unsigned threads = 0)
+	{
+		zeta3_series<I> s;
+		return series_sum(s, s.terms(digits), detail::power_of_ten<I>(digits), threads) / I(64);
+	}
+};
+
+#endif // BINARY_SPLITTING_H
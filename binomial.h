@@ -0,0 +1,246 @@
+/*
+ *  binomial.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * Exact binomial and multinomial coefficients, and binomials modulo a
+ *	prime or a prime power.  For an Integer T, C(n, k) is built by the
+ *	multiplicative formula with a gcd taken out at each step, so no
+ *	intermediate exceeds the result.  Wide types with large k switch to
+ *	the prime exponent product in factorial.h.  Modulo a prime p there
+ *	are factorial and inverse factorial tables plus Lucas' theorem.
+ *	Modulo p^e the p-free factorials are split the same way (Granville).
+ */
+
+#ifndef BINOMIAL_H
+#define BINOMIAL_H
+
+#include <vector>
+#include <limits>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <stdint.h>
+
+#include "integer.h"
+#include "gcd.h"
+#include "factorial.h"
+
+namespace num
+{
+	namespace detail
+	{
+		// past this k a wide type is cheaper through prime exponents
+		const uint64_t binomial_prime_exponent_k = 64;
+
+		// the default largest table index of binomial_mod_prime
+		const uint64_t binomial_table_limit = 1 << 20;
+
+		// C(n, k) with 0 <= k <= n - k.  after step i, r = C(n - k + i, i).
+		template<typename T>
+		T binomial_multiplicative(const T& n, const T& k)
+		{
+			T r(1);
+			for (T i(1); i <= k; ++i)
+			{	// r (n - k + i) / i is an integer and gcd(r/g, i/g) = 1, so i/g divides n - k + i
+				T g = num::gcd(r, i);
+				r /= g;
+				r *= (n - k + i) / (i / g);
+			}
+			return r;
+		}
+
+		template<typename T>
+		T binomial_coefficient(const T& n, const T& k, std::true_type)
+		{
+			return binomial_multiplicative(n, k);
+		}
+
+		template<typename T>
+		T binomial_coefficient(const T& n, const T& k, std::false_type)
+		{
+			if (k < T(binomial_prime_exponent_k) || n > T(std::numeric_limits<uint32_t>::max()))
+			{
+				return binomial_multiplicative(n, k);
+			}
+			return binomial<T>((uint64_t)n, (uint64_t)k, 1);
+		}
+	}
+
+	// C(n, k) exactly; 0 when k < 0 or k > n
+	template<typename T>
+	// requires Integer(T)
+	T binomial_coefficient(const T& n, T k)
+	{
+		if (n < T(0))
+		{
+			throw std::runtime_error("num::binomial_coefficient - n must be nonnegative.");
+		}
+		if (k < T(0) || k > n) return T(0);
+		if (k > n - k) k = n - k;
+		return detail::binomial_coefficient(n, k, std::integral_constant<bool,
+			std::numeric_limits<T>::is_integer && std::numeric_limits<T>::digits <= 64>());
+	}
+
+	// (k1 + ... + km)!/(k1! ... km!) as C(k1, k1) C(k1 + k2, k2) ..., so
+	//	no intermediate exceeds the result
+	template<typename Iterator>
+	// requires InputIterator(Iterator) && Integer(ValueType(Iterator))
+	typename std::iterator_traits<Iterator>::value_type multinomial_coefficient(Iterator first, Iterator last)
+	{
+		typedef typename std::iterator_traits<Iterator>::value_type T;
+		T r(1), n(0);
+		for (; first != last; ++first)
+		{
+			n += *first;
+			r *= binomial_coefficient(n, *first);
+		}
+		return r;
+	}
+
+	// C(n, k) mod a prime p.  tables of i! and 1/i! for i <= min(limit, p - 1)
+	//	are built once, 2 (limit + 1) T's of memory: 16 MB for a 64 bit T
+	//	at the default of 2^20.  larger n are split into base p digits by
+	//	Lucas' theorem, C(n, k) = product of C(n_i, k_i) (mod p), and a
+	//	digit past the tables costs O(k) multiplications.
+	template<typename T>
+	// requires Integer(T)
+	class binomial_mod_prime
+	{
+	public:
+		explicit binomial_mod_prime(const T& p, uint64_t limit = detail::binomial_table_limit) : _p(p)
+		{
+			if (p < T(2))
+			{
+				throw std::runtime_error("num::binomial_mod_prime - the modulus must be prime.");
+			}
+			uint64_t size = (uint64_t)p;
+			if (limit < size - 1) size = limit + 1;
+			_factorial.resize(size);
+			_inverse_factorial.resize(size);
+			_factorial[0] = T(1);
+			for (uint64_t i = 1; i < size; ++i) _factorial[i] = multiply_mod(_factorial[i - 1], T(i), _p);
+			_inverse_factorial[size - 1] = modular_inverse(_factorial[size - 1], _p);
+			for (uint64_t i = size - 1; i > 0; --i) _inverse_factorial[i - 1] = multiply_mod(_inverse_factorial[i], T(i), _p);
+		}
+
+		T operator()(T n, T k) const
+		{
+			if (k < T(0) || k > n) return T(0);
+			T r(1);
+			while (n != T(0) && r != T(0))
+			{
+				r = multiply_mod(r, small(n % _p, k % _p), _p);
+				n /= _p;
+				k /= _p;
+			}
+			return r;
+		}
+
+		const T& modulus() const { return _p; }
+
+	private:
+		// C(n, k) mod p for n, k < p
+		T small(const T& n, const T& k) const
+		{
+			if (k > n) return T(0);
+			if (n < T(_factorial.size()))
+			{
+				return multiply_mod(_factorial[(uint64_t)n], multiply_mod(_inverse_factorial[(uint64_t)k],
+																		 _inverse_factorial[(uint64_t)(n - k)], _p), _p);
+			}
+			// past the tables: n (n-1) ... (n-k+1) / k!
+			T numerator(1), denominator(1);
+			for (T i(0); i < k; ++i)
+			{
+				numerator = multiply_mod(numerator, n - i, _p);
+				denominator = multiply_mod(denominator, i + T(1), _p);
+			}
+			return multiply_mod(numerator, modular_inverse(denominator, _p), _p);
+		}
+
+		T _p;
+		std::vector<T> _factorial, _inverse_factorial;
+	};
+
+	// C(n, k) mod p^e.  with n!_p the product of the i <= n prime to p,
+	//	n! = p^L(n) n!_p (n/p)!_p ... and n!_p only depends on n mod p^e
+	//	and the count of whole blocks, so a table of p^e entries serves
+	//	every n.  C(n, k) = p^c N/(K R) with c the number of carries.
+	template<typename T>
+	// requires Integer(T)
+	class binomial_mod_prime_power
+	{
+	public:
+		binomial_mod_prime_power(const T& p, unsigned e) : _p(p), _e(e), _m(1)
+		{
+			if (p < T(2) || e == 0)
+			{
+				throw std::runtime_error("num::binomial_mod_prime_power - the modulus must be a prime power.");
+			}
+			for (unsigned i = 0; i < e; ++i) _m *= p;
+			_units.resize((uint64_t)_m);
+			_units[0] = T(1) % _m;
+			for (uint64_t i = 1; i < _units.size(); ++i)
+			{
+				_units[i] = (T(i) % _p == T(0)) ? _units[i - 1] : multiply_mod(_units[i - 1], T(i), _m);
+			}
+		}
+
+		T operator()(const T& n, const T& k) const
+		{
+			if (k < T(0) || k > n) return T(0);
+			T c = legendre_exponent(n) - legendre_exponent(k) - legendre_exponent(n - k);
+			if (c >= T(_e)) return T(0);
+
+			T r = multiply_mod(p_free_factorial(n), modular_inverse(multiply_mod(p_free_factorial(k),
+																				p_free_factorial(n - k), _m), _m), _m);
+			for (T i(0); i < c; ++i) r = multiply_mod(r, _p, _m);
+			return r;
+		}
+
+		const T& modulus() const { return _m; }
+
+	private:
+		// the exponent of p in n!
+		T legendre_exponent(T n) const
+		{
+			T e(0);
+			while (n >= _p) { n /= _p; e += n; }
+			return e;
+		}
+
+		// n! with every factor of p removed, mod p^e
+		T p_free_factorial(T n) const
+		{
+			T r = T(1) % _m;
+			const T block = _units.back();	// +-1 by Wilson's theorem for p^e
+			while (n > T(0))
+			{
+				if (block != T(1) && (n / _m) % T(2) == T(1)) r = multiply_mod(r, block, _m);
+				r = multiply_mod(r, _units[(uint64_t)(n % _m)], _m);
+				n /= _p;
+			}
+			return r;
+		}
+
+		T _p;
+		unsigned _e;
+		T _m;
+		std::vector<T> _units;	// _units[i] = product of j <= i prime to p, mod p^e
+	};
+
+	// C(n, k) in finite_integral_type, where BASE is prime
+	template<typename FIT>
+	FIT binomial_residue(const typename FIT::value_type& n, const typename FIT::value_type& k)
+	{
+		typedef typename FIT::value_type T;
+		const T p = FIT::base();
+		binomial_mod_prime<T> c(p, (uint64_t)(n < p ? n : p - T(1)));
+		return FIT(c(n, k));
+	}
+};
+
+#endif // BINOMIAL_H
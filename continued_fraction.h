@@ -0,0 +1,226 @@
+/*
+ *  continued_fraction.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * Continued fractions and rational approximation.  A double converts
+ *	exactly to the rational it holds (mantissa over a power of two), and
+ *	back to within an ulp.  Rationals expand into their partial
+ *	quotients a0 + 1/(a1 + 1/(a2 + ...)), and quotients fold back into
+ *	convergents h/k by h(i) = a(i) h(i-1) + h(i-2), which are already in
+ *	lowest terms.  limit_denominator walks the Stern-Brocot tree toward
+ *	x a whole run of same side steps (one partial quotient) at a time,
+ *	and returns the closest rational whose denominator is within bound.
+ */
+
+#ifndef CONTINUED_FRACTION_H
+#define CONTINUED_FRACTION_H
+
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include "rational.h"
+#include "big_integer.h"
+
+namespace num
+{
+	namespace detail
+	{
+		// a native double for numbers too big for one, as m 2^shift
+		template<typename T>
+		double scaled_double(const T& t, int& shift, std::true_type)
+		{
+			shift = 0;
+			return double(t);
+		}
+
+		template<typename T>
+		double scaled_double(const T& t, int& shift, std::false_type)
+		{
+			shift = bit_length(t) > 64 ? bit_length(t) - 64 : 0;
+			return double(t >> shift);
+		}
+
+		// b as a T, when it fits
+		template<typename T>
+		T narrow(const big_integer& b)
+		{
+			if (std::numeric_limits<T>::is_bounded && (b > big_integer(std::numeric_limits<T>::max())
+													   || b < big_integer(std::numeric_limits<T>::min())))
+			{
+				throw std::runtime_error("num::narrow - out of range.");
+			}
+			return T(b);
+		}
+	}
+
+	// the rational x holds exactly; T must be wide enough for it
+	template<class T, class N = eager_normalization>
+	// requires Integer(T)
+	rational<T, N> to_rational(double x)
+	{
+		if (!std::isfinite(x))
+		{
+			throw std::runtime_error("num::to_rational - x must be finite.");
+		}
+		int e;
+		long long mantissa = (long long)std::ldexp(std::frexp(x, &e), 53);	// x = mantissa 2^(e - 53)
+		e -= 53;
+		if (mantissa == 0) return rational<T, N>(T(0));
+		while (mantissa % 2 == 0 && e < 0)
+		{
+			mantissa /= 2;
+			++e;
+		}
+
+		if (std::numeric_limits<T>::is_bounded)
+		{
+			int bits = 0;
+			for (long long m = mantissa < 0 ? -mantissa : mantissa; m != 0; m >>= 1) ++bits;
+			if ((e >= 0 && bits + e > std::numeric_limits<T>::digits) || (e < 0 && -e >= std::numeric_limits<T>::digits))
+			{
+				throw std::runtime_error("num::to_rational - out of range.");
+			}
+		}
+		if (e >= 0) return rational<T, N>(T(mantissa) * (T(1) << e));
+		return rational<T, N>(T(mantissa), T(1) << -e);
+	}
+
+	// the double nearest n/d, give or take an ulp
+	template<class T, class N>
+	double to_double(const rational<T, N>& r)
+	{
+		typedef std::integral_constant<bool, std::numeric_limits<T>::is_bounded> bounded;
+		const bool negative = r.numerator() < T(0);
+		int ns, ds;
+		double n = detail::scaled_double(negative ? T(-r.numerator()) : r.numerator(), ns, bounded());
+		double d = detail::scaled_double(r.denominator(), ds, bounded());
+		double x = std::ldexp(n / d, ns - ds);
+		return negative ? -x : x;
+	}
+
+	// the partial quotients of r, a0 = floor(r) and then ai >= 1
+	template<class T, class N, class OutputIterator>
+	// requires Integer(T)
+	OutputIterator continued_fraction(const rational<T, N>& r, OutputIterator out)
+	{
+		T n = r.numerator(), d = r.denominator();
+		while (d != T(0))
+		{
+			T a = n / d, m = n - a * d;
+			if (m < T(0))
+			{	// floor, not truncation, for a negative a0
+				a -= T(1);
+				m += d;
+			}
+			*out++ = a;
+			n = d;
+			d = m;
+		}
+		return out;
+	}
+
+	// the partial quotients of the exact value of x
+	template<class T, class OutputIterator>
+	// requires Integer(T)
+	OutputIterator continued_fraction(double x, OutputIterator out)
+	{
+		std::vector<big_integer> quotients;
+		continued_fraction(to_rational<big_integer>(x), std::back_inserter(quotients));
+		for (size_t i = 0; i < quotients.size(); ++i) *out++ = detail::narrow<T>(quotients[i]);
+		return out;
+	}
+
+	// every convergent of the continued fraction [first, last), in order
+	template<class R, class InputIterator, class OutputIterator>
+	// requires InputIterator(InputIterator) && R == rational<T, N>
+	OutputIterator convergents(InputIterator first, InputIterator last, OutputIterator out)
+	{
+		typedef typename R::value_type T;
+		T h0(0), k0(1), h1(1), k1(0);
+		for (; first != last; ++first)
+		{
+			T a(*first);
+			T h = a * h1 + h0, k = a * k1 + k0;
+			*out++ = R(h, k);
+			h0 = h1; k0 = k1;
+			h1 = h; k1 = k;
+		}
+		return out;
+	}
+
+	// the value of the continued fraction [first, last)
+	template<class R, class InputIterator>
+	// requires InputIterator(InputIterator) && R == rational<T, N>
+	R from_continued_fraction(InputIterator first, InputIterator last)
+	{
+		typedef typename R::value_type T;
+		if (first == last)
+		{
+			throw std::runtime_error("num::from_continued_fraction - no partial quotients.");
+		}
+		T h0(0), k0(1), h1(1), k1(0);
+		for (; first != last; ++first)
+		{
+			T a(*first);
+			T h = a * h1 + h0, k = a * k1 + k0;
+			h0 = h1; k0 = k1;
+			h1 = h; k1 = k;
+		}
+		return R(h1, k1);
+	}
+
+	// the rational closest to x with denominator at most max_denominator.
+	//	the last convergent p1/q1 under the bound and the largest
+	//	semiconvergent (p0 + k p1)/(q0 + k q1) under it bracket x, and
+	//	between them lies nothing with a smaller denominator.
+	template<class T, class N>
+	// requires Integer(T)
+	rational<T, N> limit_denominator(const rational<T, N>& x, const T& max_denominator)
+	{
+		if (max_denominator < T(1))
+		{
+			throw std::runtime_error("num::limit_denominator - the bound must be positive.");
+		}
+		if (x.denominator() <= max_denominator) return x;
+
+		const bool negative = x.numerator() < T(0);
+		const T denominator = x.denominator();
+		T n = negative ? T(-x.numerator()) : x.numerator(), d = denominator;
+		T p0(0), q0(1), p1(1), q1(0);
+		while (true)
+		{	// x has a denominator past the bound, so d never reaches 0 here
+			T a = n / d;
+			if (q1 != T(0) && a > (max_denominator - q0) / q1) break;
+			T p2 = p0 + a * p1, q2 = q0 + a * q1;
+			p0 = p1; q0 = q1;
+			p1 = p2; q1 = q2;
+			T m = n - a * d;
+			n = d;
+			d = m;
+		}
+
+		// the two are 1/(q1 (q0 + k q1)) apart and p1/q1 is d/(q1 denominator)
+		//	from x, so p1/q1 is the closer when 2 d (q0 + k q1) <= denominator
+		const T k = (max_denominator - q0) / q1, q = q0 + k * q1;
+		rational<T, N> best = q <= denominator / (T(2) * d) ? rational<T, N>(p1, q1) : rational<T, N>(p0 + k * p1, q);
+		return negative ? -best : best;
+	}
+
+	// the same for a double, worked exactly and then brought down to T
+	template<class T>
+	// requires Integer(T)
+	rational<T> limit_denominator(double x, const T& max_denominator)
+	{
+		rational<big_integer> best = limit_denominator(to_rational<big_integer>(x), big_integer(max_denominator));
+		return rational<T>(detail::narrow<T>(best.numerator()), detail::narrow<T>(best.denominator()));
+	}
+};
+
+#endif // CONTINUED_FRACTION_H
@@ -0,0 +1,358 @@
+/*
+ *  discrete_log.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * Discrete logarithms over finite_integral_type: given a generator g
+ *	and a value h, find x with g^x == h.  Baby-step giant-step trades
+ *	memory for time, Pollard rho needs almost no memory, and
+ *	Pohlig-Hellman reduces the problem to the prime power subgroups of
+ *	the group order using either of the other two.
+ */
+
+#ifndef DISCRETE_LOG_H
+#define DISCRETE_LOG_H
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <cstddef>
+
+#include "num.h"
+#include "integer.h"
+#include "gcd.h"
+#include "integer_square_root.h"
+#include "prime_factors.h"
+#include "finite_integral_type.h"
+
+namespace num
+{
+	// open-addressing (linear probing) table from group element residue
+	//	to baby step exponent.  keys and exponents live in one contiguous
+	//	array so a probe touches a single cache line.
+	template<typename T>
+	// requires Integer(T)
+	class baby_step_table
+	{
+	public:
+		struct entry
+		{
+			T key;
+			T exponent;
+		};
+
+		// number of baby steps that fit in the given number of bytes
+		//	(the table is kept at most half full).
+		static size_t entries_for_bytes(size_t bytes)
+		{
+			size_t n = bytes / (2 * sizeof(entry));
+			return n > 0 ? n : 1;
+		}
+
+		explicit baby_step_table(size_t entries) : _size(0)
+		{
+			size_t capacity = 2;
+			while (capacity < 2 * entries) capacity <<= 1;
+			_mask = capacity - 1;
+			_slots.resize(capacity);
+			_used.assign(capacity, false);
+		}
+
+		// keep the first (smallest) exponent seen for a key
+		void insert(const T& key, const T& exponent)
+		{
+			size_t i = slot(key);
+			while (_used[i])
+			{
+				if (_slots[i].key == key) return;
+				i = (i + 1) & _mask;
+			}
+			_used[i] = true;
+			_slots[i].key = key;
+			_slots[i].exponent = exponent;
+			++_size;
+		}
+
+		bool find(const T& key, T& exponent) const
+		{
+			size_t i = slot(key);
+			while (_used[i])
+			{
+				if (_slots[i].key == key)
+				{
+					exponent = _slots[i].exponent;
+					return true;
+				}
+				i = (i + 1) & _mask;
+			}
+			return false;
+		}
+
+		size_t size() const { return _size; }
+
+	private:
+		size_t slot(const T& key) const
+		{	// fibonacci hashing
+			unsigned long long h = (unsigned long long)key * 0x9E3779B97F4A7C15ULL;
+			return (size_t)(h >> 17) & _mask;
+		}
+
+		std::vector<entry> _slots;
+		std::vector<bool> _used;
+		size_t _mask;
+		size_t _size;
+	};
+
+	// memory/time trade-off knobs for the discrete log solvers.
+	struct discrete_log_parameters
+	{
+		// baby steps stored by baby-step giant-step.  the search costs
+		//	baby_steps + order/baby_steps multiplications.  zero means
+		//	ceil(sqrt(order)), the balanced choice.
+		size_t baby_steps;
+
+		// inside Pohlig-Hellman, prime subgroups larger than this are
+		//	solved with Pollard rho instead of baby-step giant-step.
+		unsigned long long rho_threshold;
+
+		// number of random restarts Pollard rho tries before giving up.
+		unsigned rho_attempts;
+
+		discrete_log_parameters(size_t steps = 0,
+								unsigned long long threshold = 1ULL << 32,
+								unsigned attempts = 32)
+		: baby_steps(steps), rho_threshold(threshold), rho_attempts(attempts) {}
+
+		// size the baby step table to a cache of the given size in bytes
+		//	(e.g. the L2 or L3 cache).
+		template<typename T>
+		static discrete_log_parameters for_cache_size(size_t bytes)
+		{
+			return discrete_log_parameters(baby_step_table<T>::entries_for_bytes(bytes));
+		}
+	};
+
+	namespace detail
+	{
+		template<typename FIT>
+		FIT fit_power(const FIT& a, const typename FIT::value_type& n)
+		{
+			return power(a, n, mult<FIT>());
+		}
+
+		template<typename T>
+		T add_mod(const T& a, const T& b, const T& m)
+		{
+			T r = (a + b) % m;
+			return negative(r) ? r + m : r;
+		}
+	}
+
+	// baby-step giant-step.  returns x in [0, order) with g^x == h,
+	//	throwing if there is none.  order is the order of g (BASE-1 when
+	//	BASE is prime and g a generator).
+	template<typename FIT>
+	typename FIT::value_type baby_step_giant_step(const FIT& g, const FIT& h,
+												  const typename FIT::value_type& order,
+												  const discrete_log_parameters& params = discrete_log_parameters())
+	{
+		typedef typename FIT::value_type value_type;
+
+		if (!positive(order))
+		{
+			throw std::runtime_error("num::baby_step_giant_step - group order must be positive.");
+		}
+
+		value_type m = params.baby_steps > 0 ? value_type(params.baby_steps) : integer_square_root(order);
+		if (m * m < order && params.baby_steps == 0) ++m;
+		if (m > order) m = order;
+
+		baby_step_table<value_type> table((size_t)m);
+		FIT x(value_type(1));
+		for (value_type j = value_type(0); j < m; ++j)
+		{
+			table.insert(detail::residue(x), j);
+			x *= g;
+		}
+
+		// x == g^m.  walk h * g^(-m*i) until we land in the table.
+		FIT factor(modular_inverse(detail::residue(x), FIT::base()));
+		FIT gamma = h;
+		value_type giant_steps = order / m + value_type(1);
+		for (value_type i = value_type(0); i < giant_steps; ++i)
+		{
+			value_type j;
+			if (table.find(detail::residue(gamma), j))
+			{
+				return (i * m + j) % order;
+			}
+			gamma *= factor;
+		}
+		throw std::runtime_error("num::baby_step_giant_step - no logarithm exists.");
+	}
+
+	// Pollard rho for logarithms with Brent's cycle detection.  memory use
+	//	is constant.  returns x in [0, order) with g^x == h.
+	template<typename FIT>
+	typename FIT::value_type pollard_rho_log(const FIT& g, const FIT& h,
+											 const typename FIT::value_type& order,
+											 const discrete_log_parameters& params = discrete_log_parameters())
+	{
+		typedef typename FIT::value_type value_type;
+
+		if (!positive(order))
+		{
+			throw std::runtime_error("num::pollard_rho_log - group order must be positive.");
+		}
+		if (h == FIT(value_type(1))) return value_type(0);
+
+		unsigned long long seed = 0x2545F4914F6CDD1DULL;
+		for (unsigned attempt = 0; attempt < params.rho_attempts; ++attempt)
+		{
+			// random start x = g^a * h^b
+			seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+			value_type a = value_type((seed >> 33) % (unsigned long long)order);
+			seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+			value_type b = value_type((seed >> 33) % (unsigned long long)order);
+			FIT x = detail::fit_power(g, a) * detail::fit_power(h, b);
+
+			FIT y = x;
+			value_type ya = a, yb = b;
+			size_t power_of_two = 1, lambda = 0;
+			while (true)
+			{
+				// one step of the walk, partitioned on the residue
+				switch ((unsigned long long)detail::residue(x) % 3)
+				{
+					case 0:
+						x *= h;
+						b = detail::add_mod(b, value_type(1), order);
+						break;
+					case 1:
+						x *= x;
+						a = detail::add_mod(a, a, order);
+						b = detail::add_mod(b, b, order);
+						break;
+					default:
+						x *= g;
+						a = detail::add_mod(a, value_type(1), order);
+						break;
+				}
+				++lambda;
+				if (x == y) break;
+				if (lambda == power_of_two)
+				{	// move the stationary point forward (Brent)
+					y = x; ya = a; yb = b;
+					power_of_two <<= 1;
+					lambda = 0;
+				}
+			}
+
+			// g^a h^b == g^ya h^yb  =>  (b - yb) x == (ya - a)  (mod order)
+			value_type r = detail::add_mod(b, order - yb, order);
+			value_type s = detail::add_mod(ya, order - a, order);
+			value_type d = gcd(r, order);
+			if (zero(r) || !zero(s % d)) continue;
+
+			value_type n = order / d;
+			value_type x0 = n == value_type(1) ? value_type(0)
+				: multiply_mod(s / d, modular_inverse(r / d, n), n);
+			for (value_type k = value_type(0); k < d; ++k)
+			{
+				value_type candidate = x0 + k * n;
+				if (detail::fit_power(g, candidate) == h) return candidate;
+			}
+		}
+		throw std::runtime_error("num::pollard_rho_log - no logarithm found.");
+	}
+
+	namespace detail
+	{
+		// solve in the subgroup of prime order p with the solver the
+		//	parameters ask for.
+		template<typename FIT>
+		typename FIT::value_type prime_order_log(const FIT& g, const FIT& h,
+												 const typename FIT::value_type& p,
+												 const discrete_log_parameters& params)
+		{
+			if ((unsigned long long)p > params.rho_threshold)
+				return pollard_rho_log(g, h, p, params);
+			return baby_step_giant_step(g, h, p, params);
+		}
+	}
+
+	// Pohlig-Hellman.  factors the order of g with num::prime_factors and
+	//	solves one prime power subgroup at a time, combining the answers
+	//	with the chinese remainder theorem.
+	template<typename FIT>
+	typename FIT::value_type pohlig_hellman(const FIT& g, const FIT& h,
+											const typename FIT::value_type& order,
+											const discrete_log_parameters& params = discrete_log_parameters())
+	{
+		typedef typename FIT::value_type value_type;
+
+		if (!positive(order))
+		{
+			throw std::runtime_error("num::pohlig_hellman - group order must be positive.");
+		}
+		if (one(order)) return value_type(0);
+
+		std::vector<value_type> factors;
+		prime_factors(order, std::back_inserter(factors));
+		std::sort(factors.begin(), factors.end());
+
+		value_type x = value_type(0);	// solution so far ...
+		value_type modulus = value_type(1);	// ... modulo this
+		for (size_t i = 0; i < factors.size(); )
+		{
+			value_type p = factors[i];
+			size_t e = 0;
+			value_type pe = value_type(1);
+			for (; i < factors.size() && factors[i] == p; ++i, ++e) pe *= p;
+
+			// move into the subgroup of order p^e
+			FIT gi = detail::fit_power(g, order / pe);
+			FIT hi = detail::fit_power(h, order / pe);
+			FIT gamma = detail::fit_power(gi, pe / p);	// order p
+			FIT gi_inverse(modular_inverse(detail::residue(gi), FIT::base()));
+
+			// x_i = d_0 + d_1 p + ... + d_(e-1) p^(e-1)
+			value_type xi = value_type(0);
+			value_type pk = value_type(1);
+			for (size_t k = 0; k < e; ++k)
+			{
+				FIT hk = detail::fit_power(detail::fit_power(gi_inverse, xi) * hi, pe / (pk * p));
+				value_type dk = detail::prime_order_log(gamma, hk, p, params);
+				xi += dk * pk;
+				pk *= p;
+			}
+
+			// combine x (mod modulus) with xi (mod pe)
+			value_type diff = detail::add_mod(xi, pe - x % pe, pe);
+			value_type t = multiply_mod(diff, modular_inverse(modulus % pe, pe), pe);
+			x += modulus * t;
+			modulus *= pe;
+		}
+
+		if (detail::fit_power(g, x) != h)
+		{
+			throw std::runtime_error("num::pohlig_hellman - no logarithm exists.");
+		}
+		return x;
+	}
+
+	// discrete log of h to the base g in the multiplicative group modulo a
+	//	prime BASE.
+	template<typename FIT>
+	typename FIT::value_type discrete_log(const FIT& g, const FIT& h,
+										  const discrete_log_parameters& params = discrete_log_parameters())
+	{
+		typedef typename FIT::value_type value_type;
+		return pohlig_hellman(g, h, FIT::base() - value_type(1), params);
+	}
+};
+
+#endif // DISCRETE_LOG_H
@@ -0,0 +1,248 @@
+/*
+ *  ecm.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * Lenstra's elliptic curve method.  Each curve is a Montgomery curve
+ *	B y^2 = x^3 + A x^2 + x (Suyama's parametrization) worked in x-only
+ *	projective coordinates (X : Z), so there are no inversions at all.
+ *	Stage 1 multiplies a point by every prime power up to B1; stage 2
+ *	looks for one more prime in (B1, B2] with a baby-step giant-step
+ *	walk.  Curves are independent and are spread across threads.
+ *	T can be any Integer type that multiply_mod can handle, which makes
+ *	this the factoring method for numbers past 64 bits.
+ */
+
+#ifndef ECM_H
+#define ECM_H
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include <cstddef>
+#include <stdint.h>
+
+#include "integer.h"
+#include "gcd.h"
+#include "prime_sieve.h"
+#include "parallel.h"
+
+namespace num
+{
+	struct ecm_parameters
+	{
+		uint64_t B1;		// stage 1 bound
+		uint64_t B2;		// stage 2 bound
+		unsigned curves;	// curves to try before giving up
+		unsigned threads;	// 0 means one per hardware thread
+
+		// the defaults are the usual choice for factors of about 25 digits
+		ecm_parameters(uint64_t b1 = 50000, uint64_t b2 = 0, unsigned c = 300, unsigned t = 0)
+		: B1(b1), B2(b2 ? b2 : 100 * b1), curves(c), threads(t) {}
+	};
+
+	namespace detail
+	{
+		// arithmetic modulo n.  values may be kept in some internal form
+		//	(to/from convert); gcd(form(x), n) == gcd(x, n) must hold.
+		template<typename T>
+		class ecm_ring
+		{
+		public:
+			explicit ecm_ring(const T& n) : _n(n) {}
+			T to(const T& x) const { return x % _n; }
+			T from(const T& x) const { return x; }
+			T multiply(const T& a, const T& b) const { return multiply_mod(a, b, _n); }
+			T add(const T& a, const T& b) const { return a >= _n - b ? a - (_n - b) : a + b; }
+			T subtract(const T& a, const T& b) const { return a >= b ? a - b : a + (_n - b); }
+			const T& modulus() const { return _n; }
+		private:
+			T _n;
+		};
+
+		template<typename T>
+		struct ecm_point
+		{
+			T X, Z;
+		};
+
+		template<typename T>
+		class montgomery_curve
+		{
+		public:
+			typedef ecm_point<T> point;
+
+			// a24 = (A + 2)/4 = a / d, kept as a fraction
+			montgomery_curve(const ecm_ring<T>& ring, const T& a, const T& d) : _r(ring), _a(a), _d(d) {}
+
+			point twice(const point& P) const
+			{
+				T s = _r.add(P.X, P.Z), t = _r.subtract(P.X, P.Z);
+				T s2 = _r.multiply(s, s), t2 = _r.multiply(t, t);
+				T xz4 = _r.subtract(s2, t2);	// 4XZ
+				point R;
+				T t2d = _r.multiply(t2, _d);
+				R.X = _r.multiply(s2, t2d);
+				R.Z = _r.multiply(xz4, _r.add(t2d, _r.multiply(_a, xz4)));
+				return R;
+			}
+
+			// P + Q given P - Q
+			point sum(const point& P, const point& Q, const point& difference) const
+			{
+				T u = _r.multiply(_r.subtract(P.X, P.Z), _r.add(Q.X, Q.Z));
+				T v = _r.multiply(_r.add(P.X, P.Z), _r.subtract(Q.X, Q.Z));
+				T plus = _r.add(u, v), minus = _r.subtract(u, v);
+				point R;
+				R.X = _r.multiply(difference.Z, _r.multiply(plus, plus));
+				R.Z = _r.multiply(difference.X, _r.multiply(minus, minus));
+				return R;
+			}
+
+			// [k]P by the montgomery ladder
+			point multiple(const point& P, uint64_t k) const
+			{
+				if (k == 1) return P;
+				point R0 = P, R1 = twice(P);
+				int bit = 63;
+				while (((k >> bit) & 1) == 0) --bit;
+				for (--bit; bit >= 0; --bit)
+				{
+					if ((k >> bit) & 1)
+					{
+						R0 = sum(R1, R0, P);
+						R1 = twice(R1);
+					}
+					else
+					{
+						R1 = sum(R1, R0, P);
+						R0 = twice(R0);
+					}
+				}
+				return R0;
+			}
+
+		private:
+			const ecm_ring<T>& _r;
+			T _a, _d;
+		};
+
+		// one curve.  returns a factor of n, or n (or 1) if this curve failed.
+		template<typename T>
+		T ecm_curve(const T& n, uint64_t sigma, const ecm_parameters& params,
+					const std::vector<uint32_t>& primes, const std::vector<bool>& stage2_primes)
+		{
+			typedef ecm_point<T> point;
+			ecm_ring<T> r(n);
+
+			// Suyama: u = sigma^2 - 5, v = 4 sigma, x0 = u^3 / v^3,
+			//	(A + 2)/4 = (v - u)^3 (3u + v) / (16 u^3 v)
+			T s = r.to(T(sigma));
+			T u = r.subtract(r.multiply(s, s), r.to(T(5)));
+			T v = r.multiply(r.to(T(4)), s);
+			T u3 = r.multiply(r.multiply(u, u), u);
+			T v3 = r.multiply(r.multiply(v, v), v);
+			T vu = r.subtract(v, u);
+			T a = r.multiply(r.multiply(r.multiply(vu, vu), vu), r.add(r.multiply(r.to(T(3)), u), v));
+			T d = r.multiply(r.multiply(r.to(T(16)), u3), v);
+			T g = num::gcd(r.from(d), n);
+			if (g != T(1)) return g;
+
+			montgomery_curve<T> curve(r, a, d);
+			point Q = { u3, v3 };
+
+			// stage 1
+			for (size_t i = 0; i < primes.size() && primes[i] <= params.B1; ++i)
+			{
+				uint64_t q = primes[i];
+				while (q <= params.B1 / primes[i]) q *= primes[i];
+				Q = curve.multiple(Q, q);
+			}
+			g = num::gcd(r.from(Q.Z), n);
+			if (g != T(1)) return g;
+
+			// stage 2.  with D = 210, every prime q in (B1, B2] is m*D +- j
+			//	for some 0 < j < D/2 prime to D, and [mD]Q and [j]Q have the
+			//	same x exactly when the order of Q modulo p divides q.
+			const uint64_t D = 210;
+			std::vector<point> baby(D / 2);	// baby[j] = [j]Q for odd j
+			point Q2 = curve.twice(Q);
+			baby[1] = Q;
+			baby[3] = curve.sum(Q2, Q, Q);
+			for (uint64_t j = 5; j < D / 2; j += 2) baby[j] = curve.sum(baby[j - 2], Q2, baby[j - 4]);
+
+			point QD = curve.multiple(Q, D);
+			uint64_t m = std::max<uint64_t>(1, params.B1 / D);
+			point previous = curve.multiple(Q, (m - 1) * D > 0 ? (m - 1) * D : D);
+			point giant = curve.multiple(Q, m * D);
+			bool first = (m == 1);	// [0]Q has no x coordinate; step from [D] and [2D] instead
+			T accumulated = r.to(T(1));
+			for (; m * D <= params.B2 + D; ++m)
+			{
+				for (uint64_t j = 1; j < D / 2; j += 2)
+				{
+					if (num::gcd(j, D) != 1) continue;
+					uint64_t lo = m * D - j, hi = m * D + j;
+					bool wanted = (lo > params.B1 && lo <= params.B2 && stage2_primes[lo])
+						|| (hi > params.B1 && hi <= params.B2 && stage2_primes[hi]);
+					if (!wanted) continue;
+					accumulated = r.multiply(accumulated,
+											 r.subtract(r.multiply(giant.X, baby[j].Z), r.multiply(baby[j].X, giant.Z)));
+				}
+				point next = first ? curve.twice(giant) : curve.sum(giant, QD, previous);
+				first = false;
+				previous = giant;
+				giant = next;
+			}
+			return num::gcd(r.from(accumulated), n);
+		}
+	}
+
+	// look for a nontrivial factor of the composite n with up to
+	//	params.curves curves, several threads at a time.  returns n if
+	//	no curve succeeded.
+	template<typename T>
+	// requires Integer(T)
+	T ecm_factor(const T& n, const ecm_parameters& params = ecm_parameters())
+	{
+		if (even(n)) return T(2);
+
+		std::vector<uint32_t> primes;
+		prime_sieve sieve(params.B2);
+		sieve.primes(0, params.B1, std::back_inserter(primes));
+		std::vector<bool> stage2_primes(params.B2 + 1, false);
+		sieve.for_each_prime(params.B1 + 1, params.B2, [&stage2_primes](uint64_t p) { stage2_primes[p] = true; });
+
+		unsigned threads = params.threads ? params.threads : hardware_threads();
+		if (threads > params.curves) threads = params.curves;
+
+		std::atomic<bool> found(false);
+		std::mutex lock;
+		T factor = n;
+		auto worker = [&](unsigned t)
+		{
+			for (unsigned c = t; c < params.curves && !found; c += threads)
+			{
+				T g = detail::ecm_curve(n, 6 + (uint64_t)c, params, primes, stage2_primes);
+				if (g != T(1) && g != n)
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					if (!found) factor = g;
+					found = true;
+				}
+			}
+		};
+
+		std::vector<std::thread> workers;
+		for (unsigned t = 1; t < threads; ++t) workers.push_back(std::thread(worker, t));
+		worker(0);
+		for (size_t i = 0; i < workers.size(); ++i) workers[i].join();
+		return factor;
+	}
+};
+
+#endif // ECM_H
@@ -0,0 +1,239 @@
+/*
+ *  factorial.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * Factorials and their relatives as exact integers.  n! uses Luschny's
+ *	prime swing: n! = ((n/2)!)^2 swing(n), where swing(n) = n!/((n/2)!)^2
+ *	is a product of prime powers each no larger than n that a sieve and
+ *	a little counting give directly.  binomials and multinomials are
+ *	prime power products the same way (Legendre's formula).  every
+ *	product is taken over a balanced tree of word sized factors, with
+ *	the subtrees run as jobs on a thread pool.  I is the result type,
+ *	normally big_integer.
+ */
+
+#ifndef FACTORIAL_H
+#define FACTORIAL_H
+
+#include <vector>
+#include <limits>
+#include <memory>
+#include <iterator>
+#include <cstddef>
+#include <stdint.h>
+
+#include "prime_sieve.h"
+#include "parallel.h"
+
+namespace num
+{
+	namespace detail
+	{
+		// below this many word factors a product stays on one thread
+		const size_t parallel_product_grain = 512;
+
+		// below this much work (n or k) the factorials run without a pool
+		const uint64_t parallel_product_work = 16 * parallel_product_grain;
+
+		// collects factors, multiplying them together while they fit in a word
+		class factor_packer
+		{
+		public:
+			explicit factor_packer(std::vector<uint64_t>& out) : _out(out), _word(1) {}
+			~factor_packer() { flush(); }
+
+			void push(uint64_t x)
+			{
+				if (_word > std::numeric_limits<uint64_t>::max() / x)
+				{
+					_out.push_back(_word);
+					_word = x;
+				}
+				else _word *= x;
+			}
+
+			void flush()
+			{
+				if (_word > 1) _out.push_back(_word);
+				_word = 1;
+			}
+		private:
+			std::vector<uint64_t>& _out;
+			uint64_t _word;
+		};
+
+		template<typename I>
+		I balanced_product(const std::vector<uint64_t>& f, size_t lo, size_t hi)
+		{
+			switch (hi - lo)
+			{
+				case 0:
+					return I(1);
+				case 1:
+					return I(f[lo]);
+				case 2:
+					return I(f[lo]) * I(f[lo + 1]);
+				default:
+				{
+					size_t mid = lo + (hi - lo) / 2;
+					return balanced_product<I>(f, lo, mid) * balanced_product<I>(f, mid, hi);
+				}
+			}
+		}
+
+		// the product of f over a balanced tree, shared out on pool
+		template<typename I>
+		I product(const std::vector<uint64_t>& f, thread_pool* pool)
+		{
+			return parallel_tree_reduce<I>(f.size(), [&f](size_t lo, size_t hi) { return balanced_product<I>(f, lo, hi); },
+										   [](const I& a, const I& b) { return a * b; }, pool, parallel_product_grain);
+		}
+
+		inline std::vector<uint64_t> primes_through(uint64_t n)
+		{
+			std::vector<uint64_t> primes;
+			if (n >= 2) prime_sieve(n).primes(0, n, std::back_inserter(primes));
+			return primes;
+		}
+
+		// Legendre: the exponent of p in n!
+		inline uint64_t factorial_exponent(uint64_t n, uint64_t p)
+		{
+			uint64_t e = 0;
+			while (n >= p) { n /= p; e += n; }
+			return e;
+		}
+
+		// the prime powers of swing(n) = n!/((n/2)!)^2
+		inline void swing_factors(uint64_t n, const std::vector<uint64_t>& primes, std::vector<uint64_t>& out)
+		{
+			factor_packer packer(out);
+			for (size_t i = 0; i < primes.size() && primes[i] <= n; ++i)
+			{
+				const uint64_t p = primes[i];
+				if (p > n / 2) packer.push(p);
+				else if (p > n / 3) continue;
+				else if (p > n / p)
+				{
+					if ((n / p) & 1) packer.push(p);
+				}
+				else
+				{	// p^e with e the number of odd floor(n/p^j)
+					uint64_t q = n, f = 1;
+					while ((q /= p) > 0) if (q & 1) f *= p;
+					if (f > 1) packer.push(f);
+				}
+			}
+		}
+
+		template<typename I>
+		I factorial(uint64_t n, const std::vector<uint64_t>& primes, thread_pool* pool)
+		{
+			if (n < 21)
+			{
+				uint64_t f = 1;
+				for (uint64_t i = 2; i <= n; ++i) f *= i;
+				return I(f);
+			}
+			I half = factorial<I>(n / 2, primes, pool);
+			std::vector<uint64_t> swing;
+			swing_factors(n, primes, swing);
+			return half * half * product<I>(swing, pool);
+		}
+	}
+
+	// n!
+	template<typename I>
+	// requires Integer(I)
+	I factorial(uint64_t n, unsigned threads = 0)
+	{
+		std::unique_ptr<thread_pool> pool;
+		return detail::factorial<I>(n, detail::primes_through(n), pool_for(pool, n, detail::parallel_product_work, threads));
+	}
+
+	// n (n-1) ... (n-k+1) = n!/(n-k)!
+	template<typename I>
+	// requires Integer(I)
+	I falling_factorial(uint64_t n, uint64_t k, unsigned threads = 0)
+	{
+		if (k > n) return I(0);
+		std::vector<uint64_t> factors;
+		{
+			detail::factor_packer packer(factors);
+			for (uint64_t i = n - k + 1; i <= n && i != 0; ++i) packer.push(i);
+		}
+		std::unique_ptr<thread_pool> pool;
+		return detail::product<I>(factors, pool_for(pool, k, detail::parallel_product_work, threads));
+	}
+
+	// n!/(k!(n-k)!) as the product of p^e over primes p <= n, where e
+	//	is the number of carries adding k and n-k in base p (Kummer)
+	template<typename I>
+	// requires Integer(I)
+	I binomial(uint64_t n, uint64_t k, unsigned threads = 0)
+	{
+		if (k > n) return I(0);
+		if (k > n - k) k = n - k;
+		if (k == 0) return I(1);
+
+		std::vector<uint64_t> primes = detail::primes_through(n);
+		std::vector<uint64_t> factors;
+		{
+			detail::factor_packer packer(factors);
+			for (size_t i = 0; i < primes.size(); ++i)
+			{
+				const uint64_t p = primes[i];
+				if (p > n - k) packer.push(p);
+				else if (p > n / 2) continue;
+				else if (p > n / p)
+				{
+					if (n % p < k % p) packer.push(p);
+				}
+				else
+				{	// p^e <= n
+					uint64_t f = 1;
+					for (uint64_t a = n, b = k, borrow = 0; a > 0; a /= p, b /= p)
+					{
+						borrow = (a % p < b % p + borrow) ? 1 : 0;
+						if (borrow) f *= p;
+					}
+					if (f > 1) packer.push(f);
+				}
+			}
+		}
+		std::unique_ptr<thread_pool> pool;
+		return detail::product<I>(factors, pool_for(pool, n, detail::parallel_product_work, threads));
+	}
+
+	// (k1 + ... + km)!/(k1! ... km!) for the counts in [first, last)
+	template<typename I, typename Iterator>
+	// requires Integer(I) && InputIterator(Iterator) && Integer(ValueType(Iterator))
+	I multinomial(Iterator first, Iterator last, unsigned threads = 0)
+	{
+		std::vector<uint64_t> counts(first, last);
+		uint64_t n = 0;
+		for (size_t i = 0; i < counts.size(); ++i) n += counts[i];
+
+		std::vector<uint64_t> primes = detail::primes_through(n);
+		std::vector<uint64_t> factors;
+		{
+			detail::factor_packer packer(factors);
+			for (size_t i = 0; i < primes.size(); ++i)
+			{
+				uint64_t e = detail::factorial_exponent(n, primes[i]);
+				for (size_t j = 0; j < counts.size() && e > 0; ++j)
+				{
+					if (counts[j] >= primes[i]) e -= detail::factorial_exponent(counts[j], primes[i]);
+				}
+				for (; e > 0; --e) packer.push(primes[i]);
+			}
+		}
+		std::unique_ptr<thread_pool> pool;
+		return detail::product<I>(factors, pool_for(pool, n, detail::parallel_product_work, threads));
+	}
+};
+
+#endif // FACTORIAL_H
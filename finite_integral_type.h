@@ -13,15 +13,24 @@
 #include <vector>
 #include <set>
 #include <stdexcept>
+#include <limits>
 
 #include "num.h"
+#include "integer.h"
+#include "gcd.h"
 
 namespace num
 {
+	// products go through multiply_mod, so T only has to hold the sum
+	//	of two residues: a signed T needs 2 BASE <= max, and an unsigned T
+	//	keeps its residues in [0, BASE) and never negates.  a wide integer
+	//	(wide_uint<256>, say) works for cryptographic moduli from C++20.
 	template<typename T, T BASE>
 	//requires Integer(T) && Positive(BASE)
 	class finite_integral_type
 	{
+		static_assert(!std::numeric_limits<T>::is_signed || BASE <= std::numeric_limits<T>::max() / T(2),
+					  "num::finite_integral_type - a signed T must hold 2 BASE.");
 	public:
 		typedef T value_type;
 		typedef finite_integral_type self_type;
@@ -47,26 +56,38 @@ namespace num
 		// return a multiplicative inverse (if any) of *this
 		const finite_integral_type invert() const
 		{
-			for (self_type a(T(1)); a.value() != T(0); ++a)
+			T r = _value % BASE;
+			if (r < T(0)) r += BASE;
+			try
 			{
-				if ((a * (*this)) == self_type(T(1)))
-				{
-					return a;
-				}
+				return self_type(modular_inverse(r, BASE));
+			}
+			catch (std::runtime_error&)
+			{
+				throw std::runtime_error("num::finite_integral_type::invert() - no inverse exists.");
 			}
-			throw std::runtime_error("num::finite_integral_type::invert() - no inverse exists.");
 		}
 		
 		// overloads
 		const finite_integral_type operator-() const // unary
 		{
 			finite_integral_type a(*this);
+			if (!std::numeric_limits<T>::is_signed)
+			{
+				if (a._value != T(0)) a._value = BASE - a._value;
+				return a;
+			}
 			a._value = -a._value;
 			return a.normalize();
 		}
 		
 		finite_integral_type& operator+=(const finite_integral_type& a)
 		{
+			if (!std::numeric_limits<T>::is_signed)
+			{	// both are below BASE, but their sum may not fit
+				_value = (_value >= BASE - a._value) ? _value - (BASE - a._value) : _value + a._value;
+				return *this;
+			}
 			_value = mod(_value + a._value);
 			return *this;
 		}
@@ -79,7 +100,7 @@ namespace num
 		
 		finite_integral_type& operator*=(const finite_integral_type& a)
 		{
-			_value = mod(_value * a._value);
+			_value = multiply_mod(_value, a._value, BASE);
 			return *this;
 		}
 		
@@ -88,7 +109,7 @@ namespace num
 			if (a._value == T(0))
 				throw std::runtime_error("num::finite_integral_type::operator/= - Division by zero error.");
 			self_type b(a);
-			_value = mod(_value *= b.invert().value());
+			_value = multiply_mod(_value, b.invert().value(), BASE);
 			return *this;
 		}
 		
@@ -123,7 +144,7 @@ namespace num
 		//	when the number is higher(lower) than 1/2 base
 		const finite_integral_type& normalize() 
 		{ 
-			if (_value == T(0)) return *this;
+			if (_value == T(0) || !std::numeric_limits<T>::is_signed) return *this;
 			if (_value < T(0))
 			{
 				if (_value < -BASE/T(2))
@@ -201,6 +222,18 @@ namespace num
 		}
 	};
 	
+	namespace detail
+	{
+		// the canonical residue of a finite integral type in [0, BASE)
+		template<typename FIT>
+		typename FIT::value_type residue(const FIT& f)
+		{
+			typedef typename FIT::value_type value_type;
+			value_type v = f.value() % FIT::base();
+			return v < value_type(0) ? v + FIT::base() : v;
+		}
+	}
+	
 	// useful for associative containers.
 	template<typename FIT>
 	class less
@@ -9,24 +9,222 @@
 #ifndef GCD_H
 #define GCD_H
 
+#include <stdexcept>
+#include <limits>
+#include <type_traits>
+
 namespace num
 {
+	namespace detail
+	{
+		// which gcd fits T: native integers get the binary algorithm, wider
+		//	integer types get Lehmer's, anything else keeps Euclid's.
+		struct binary_gcd_tag {};
+		struct lehmer_gcd_tag {};
+		struct euclid_gcd_tag {};
+		
+		template<class T, bool INTEGER = std::numeric_limits<T>::is_integer,
+				 bool NATIVE = (std::numeric_limits<T>::digits <= 64)>
+		struct gcd_category { typedef euclid_gcd_tag type; };
+		template<class T>
+		struct gcd_category<T, true, true> { typedef binary_gcd_tag type; };
+		template<class T>
+		struct gcd_category<T, true, false> { typedef lehmer_gcd_tag type; };
+		
+		inline int count_trailing_zeros(unsigned long long x)
+		{	// x != 0
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_ctzll(x);
+#else
+			int n = 0;
+			while ((x & 1) == 0) { x >>= 1; ++n; }
+			return n;
+#endif
+		}
+		
+		inline int bit_length(unsigned long long x)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return x == 0 ? 0 : 64 - __builtin_clzll(x);
+#else
+			int n = 0;
+			for (; x != 0; x >>= 1) ++n;
+			return n;
+#endif
+		}
+		
+		// Stein's algorithm: strip the common power of two once, then
+		//	replace the larger odd number by the difference with its
+		//	trailing zeros shifted out.  written without branches in the
+		//	loop so the compiler can use conditional moves.
+		inline unsigned long long binary_gcd(unsigned long long u, unsigned long long v)
+		{
+			if (u == 0) return v;
+			if (v == 0) return u;
+			const int shift = count_trailing_zeros(u | v);
+			u >>= count_trailing_zeros(u);
+			v >>= count_trailing_zeros(v);
+			while (u != v)
+			{
+				const unsigned long long d = u - v;
+				const int z = count_trailing_zeros(d);	// same for v - u
+				const unsigned long long smaller = u < v ? u : v;
+				u = (u > v ? d : v - u) >> z;
+				v = smaller;
+			}
+			return u << shift;
+		}
+		
+		template<class T>
+		unsigned long long magnitude(const T& x, const std::true_type&)
+		{
+			return x < T(0) ? 0ULL - (unsigned long long)x : (unsigned long long)x;
+		}
+		
+		template<class T>
+		unsigned long long magnitude(const T& x, const std::false_type&)
+		{
+			return (unsigned long long)x;
+		}
+		
+		template<class T>
+		T gcd(const T& x, const T& y, binary_gcd_tag)
+		{
+			typedef std::integral_constant<bool, std::numeric_limits<T>::is_signed> is_signed;
+			return T(binary_gcd(magnitude(x, is_signed()), magnitude(y, is_signed())));
+		}
+		
+		template<class T>
+		T gcd(T x, T y, euclid_gcd_tag)
+		{	// calculate the greatest common divisor of x and y
+			// using Euclid's algorithm.
+			T swap;
+			while (y != T(0))
+			{
+				swap = y;
+				y = x % y;
+				x = swap;
+			}
+			return x;
+		}
+		
+		// number of significant bits of x >= 0.  wide integer types with
+		//	a faster way can overload bit_length in their own namespace.
+		template<class T>
+		int bit_length(T x)
+		{
+			int n = 0;
+			while (x >> 64 != T(0)) { x >>= 64; n += 64; }
+			return n + bit_length((unsigned long long)x);
+		}
+		
+		// a*x + b*y for Lehmer cofactors, where a and b never have the same
+		//	strict sign and the result is never negative.
+		template<class T>
+		T combine(long long a, const T& x, long long b, const T& y)
+		{
+			if (b <= 0)
+				return T((unsigned long long)a) * x - T(0ULL - (unsigned long long)b) * y;
+			return T((unsigned long long)b) * y - T(0ULL - (unsigned long long)a) * x;
+		}
+		
+		// Lehmer's algorithm: run Euclid on the leading 62 bits of x and y
+		//	in single precision for as long as the quotients are certain to
+		//	be those of the full numbers, then apply all those steps to x and
+		//	y at once.  one multiprecision update replaces many divisions.
+		template<class T>
+		T gcd(T x, T y, lehmer_gcd_tag)
+		{
+			if (x < T(0)) x = -x;
+			if (y < T(0)) y = -y;
+			if (x < y) { T t = x; x = y; y = t; }
+			
+			while (bit_length(y) > 64)
+			{
+				const int k = bit_length(x) - 62;
+				long long xh = (long long)(unsigned long long)(x >> k);
+				long long yh = (long long)(unsigned long long)(y >> k);
+				long long A = 1, B = 0, C = 0, D = 1;
+				while (yh + C != 0 && yh + D != 0)
+				{
+					const long long q = (xh + A) / (yh + C);
+					if (q != (xh + B) / (yh + D)) break;
+					long long t;
+					t = A - q * C; A = C; C = t;
+					t = B - q * D; B = D; D = t;
+					t = xh - q * yh; xh = yh; yh = t;
+				}
+				if (B == 0)
+				{	// no certain quotient; take a full step
+					T r = x % y;
+					x = y;
+					y = r;
+				}
+				else
+				{
+					T nx = combine(A, x, B, y);
+					T ny = combine(C, x, D, y);
+					x = nx;
+					y = ny;
+				}
+			}
+			if (y == T(0)) return x;
+			return T(binary_gcd((unsigned long long)y, (unsigned long long)(x % y)));
+		}
+	}
+	
 	template<class T>
 	// requires Integer(T)
 	T gcd(T x, T y)
-	{	// calculate the greatest common divisor of x and y
-		// using Euclid's algorithm.
-		T swap;
+	{	// the greatest common divisor of x and y, by the fastest
+		// algorithm for T.  nonnegative for integer types.
+		return detail::gcd(x, y, typename detail::gcd_category<T>::type());
+	}
+	
+	template<class T>
+	// requires Integer(T)
+	T extended_gcd(T x, T y, T& a, T& b)
+	{	// calculate g = gcd(x, y) along with Bezout coefficients
+		// a and b such that a*x + b*y == g.
+		T a1 = T(1), b1 = T(0);
+		T a2 = T(0), b2 = T(1);
+		T q, swap;
 		while (y != T(0))
 		{
-			swap = y;
-			y = x % y;
-			x = swap;
+			q = x / y;
+			swap = y; y = x - q*y; x = swap;
+			swap = a2; a2 = a1 - q*a2; a1 = swap;
+			swap = b2; b2 = b1 - q*b2; b1 = swap;
 		}
+		a = a1;
+		b = b1;
 		return x;
 	}
 	
-
+	template<class T>
+	// requires Integer(T) && Positive(m)
+	T modular_inverse(const T& x, const T& m)
+	{	// return the inverse of x in [0, m) or throw if x and m
+		// are not relatively prime.  the Bezout coefficients of x alternate
+		// in sign, so only their magnitudes (all at most m) are kept, and
+		// an unsigned T never wraps.
+		T r0 = m, r1 = x % m;
+		if (r1 < T(0)) r1 += m;
+		T u0 = T(0), u1 = T(1), q, swap;
+		bool positive = true;	// the sign of the coefficient of r1
+		while (r1 != T(0))
+		{
+			q = r0 / r1;
+			swap = r1; r1 = r0 - q*r1; r0 = swap;
+			swap = u1; u1 = u0 + q*u1; u0 = swap;
+			positive = !positive;
+		}
+		if (r0 != T(1) || m == T(1))
+		{
+			throw std::runtime_error("num::modular_inverse - no inverse exists.");
+		}
+		return positive ? m - u0 : u0;
+	}
 }
 
 #endif // GCD_H
@@ -0,0 +1,297 @@
+/*
+ *  hybrid_rational.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * A rational number that keeps its numerator and denominator in two
+ *	long longs while they fit and switches to a wide integer type (by
+ *	default big_integer) when an operation overflows.  Every small
+ *	operation is checked with the compiler's overflow builtins.  Results
+ *	of wide arithmetic that fit again go back to the small form, so a
+ *	value that only passes through large intermediates stays fast.
+ *	Values are always in lowest terms with a positive denominator.
+ */
+
+#ifndef HYBRID_RATIONAL_H
+#define HYBRID_RATIONAL_H
+
+#include <memory>
+#include <climits>
+#include <ostream>
+#include <stdexcept>
+
+#include "gcd.h"
+#include "rational.h"
+#include "big_integer.h"
+
+namespace num
+{
+	namespace detail
+	{
+		// r = a op b, returning true on overflow
+		inline bool multiply_overflows(long long a, long long b, long long& r)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_mul_overflow(a, b, &r);
+#else
+			if (a != 0 && ((b > 0 && (a > LLONG_MAX / b || a < LLONG_MIN / b))
+						|| (b < 0 && (a > LLONG_MIN / b || a < LLONG_MAX / b)))) return true;
+			if (a == -1 && b == LLONG_MIN) return true;
+			r = a * b;
+			return false;
+#endif
+		}
+
+		inline bool add_overflows(long long a, long long b, long long& r)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_add_overflow(a, b, &r);
+#else
+			if ((b > 0 && a > LLONG_MAX - b) || (b < 0 && a < LLONG_MIN - b)) return true;
+			r = a + b;
+			return false;
+#endif
+		}
+
+		// detail::henrici_sum and henrici_product on long longs; false
+		//	when anything overflows or the result would be LLONG_MIN, which
+		//	has no negation
+		inline bool small_henrici_sum(long long n1, long long d1, long long n2, long long d2, long long& n, long long& d)
+		{
+			long long g = num::gcd(d1, d2), a, b;
+			if (g == 1)
+			{
+				return !(multiply_overflows(n1, d2, a) || multiply_overflows(n2, d1, b) || add_overflows(a, b, n)
+						 || multiply_overflows(d1, d2, d) || n == LLONG_MIN);
+			}
+			long long t;
+			if (multiply_overflows(n1, d2 / g, a) || multiply_overflows(n2, d1 / g, b) || add_overflows(a, b, t)) return false;
+			if (t == 0) { n = 0; d = 1; return true; }
+			long long g2 = num::gcd(t, g);
+			n = t / g2;
+			return !(multiply_overflows(d1 / g, d2 / g2, d) || n == LLONG_MIN);
+		}
+
+		inline bool small_henrici_product(long long n1, long long d1, long long n2, long long d2, long long& n, long long& d)
+		{
+			if (n1 == 0 || n2 == 0) { n = 0; d = 1; return true; }
+			long long g1 = num::gcd(n1, d2), g2 = num::gcd(n2, d1);
+			return !(multiply_overflows(n1 / g1, n2 / g2, n) || multiply_overflows(d1 / g2, d2 / g1, d) || n == LLONG_MIN);
+		}
+	}
+
+	template<class Wide = big_integer>
+	// requires Integer(Wide)
+	class hybrid_rational
+	{
+	public:
+		typedef Wide wide_type;
+
+		hybrid_rational(long long num = 0, long long denom = 1) : _num(num), _denom(denom)
+		{
+			if (denom == 0) throw std::runtime_error("num::hybrid_rational - zero denominator.");
+			if (num == LLONG_MIN || denom == LLONG_MIN) set(Wide(num), Wide(denom));
+			else normalize_small();
+		}
+
+		hybrid_rational(const Wide& num, const Wide& denom) : _num(0), _denom(1)
+		{
+			if (denom == Wide(0)) throw std::runtime_error("num::hybrid_rational - zero denominator.");
+			set(num, denom);
+		}
+
+		hybrid_rational(const hybrid_rational& r) : _num(r._num), _denom(r._denom), _wide(r._wide ? new wide_pair(*r._wide) : 0) {}
+
+		hybrid_rational& operator=(const hybrid_rational& r)
+		{
+			if (this != &r)
+			{
+				_num = r._num;
+				_denom = r._denom;
+				_wide.reset(r._wide ? new wide_pair(*r._wide) : 0);
+			}
+			return *this;
+		}
+
+		// whether the value is held in the two long longs
+		bool is_small() const { return !_wide; }
+
+		Wide numerator() const { return _wide ? _wide->num : Wide(_num); }
+		Wide denominator() const { return _wide ? _wide->denom : Wide(_denom); }
+
+		const hybrid_rational operator-() const
+		{
+			hybrid_rational r(*this);
+			if (r._wide) r._wide->num = -r._wide->num;
+			else r._num = -r._num;
+			return r;
+		}
+
+		hybrid_rational& operator+=(const hybrid_rational& r)
+		{
+			long long n, d;
+			if (!_wide && !r._wide && detail::small_henrici_sum(_num, _denom, r._num, r._denom, n, d))
+			{
+				_num = n; _denom = d;
+				return *this;
+			}
+			Wide wn, wd;
+			detail::henrici_sum(numerator(), denominator(), r.numerator(), r.denominator(), wn, wd);
+			set_reduced(wn, wd);
+			return *this;
+		}
+
+		hybrid_rational& operator-=(const hybrid_rational& r)
+		{
+			return *this += -r;
+		}
+
+		hybrid_rational& operator*=(const hybrid_rational& r)
+		{
+			long long n, d;
+			if (!_wide && !r._wide && detail::small_henrici_product(_num, _denom, r._num, r._denom, n, d))
+			{
+				_num = n; _denom = d;
+				return *this;
+			}
+			Wide wn, wd;
+			detail::henrici_product(numerator(), denominator(), r.numerator(), r.denominator(), wn, wd);
+			set_reduced(wn, wd);
+			return *this;
+		}
+
+		hybrid_rational& operator/=(const hybrid_rational& r)
+		{
+			hybrid_rational inverse(r);
+			return *this *= inverse.invert();
+		}
+
+		hybrid_rational& invert()
+		{
+			if (sign() == 0) throw std::runtime_error("num::hybrid_rational - zero denominator.");
+			if (_wide)
+			{
+				Wide swap = _wide->num;
+				_wide->num = _wide->denom;
+				_wide->denom = swap;
+				if (_wide->denom < Wide(0)) { _wide->num = -_wide->num; _wide->denom = -_wide->denom; }
+			}
+			else
+			{
+				long long swap = _num;
+				_num = _denom;
+				_denom = swap;
+				if (_denom < 0) { _num = -_num; _denom = -_denom; }
+			}
+			return *this;
+		}
+
+		int sign() const
+		{
+			if (_wide) return _wide->num < Wide(0) ? -1 : (_wide->num == Wide(0) ? 0 : 1);
+			return _num < 0 ? -1 : (_num == 0 ? 0 : 1);
+		}
+
+		friend const hybrid_rational operator+(hybrid_rational l, const hybrid_rational& r) { return l += r; }
+		friend const hybrid_rational operator-(hybrid_rational l, const hybrid_rational& r) { return l -= r; }
+		friend const hybrid_rational operator*(hybrid_rational l, const hybrid_rational& r) { return l *= r; }
+		friend const hybrid_rational operator/(hybrid_rational l, const hybrid_rational& r) { return l /= r; }
+
+		friend std::ostream& operator<<(std::ostream& os, const hybrid_rational& r)
+		{
+			os << "(" << r.numerator() << ", " << r.denominator() << ")";
+			return os;
+		}
+
+		// both sides are in lowest terms, and a small value never equals a wide one
+		friend bool operator==(const hybrid_rational& l, const hybrid_rational& r)
+		{
+			if (!l._wide && !r._wide) return l._num == r._num && l._denom == r._denom;
+			if (!l._wide || !r._wide) return false;
+			return l._wide->num == r._wide->num && l._wide->denom == r._wide->denom;
+		}
+
+		friend bool operator!=(const hybrid_rational& l, const hybrid_rational& r) { return !(l == r); }
+
+		// by cross multiplication: n1/d1 < n2/d2 exactly when n1 d2 < n2 d1
+		friend bool operator<(const hybrid_rational& l, const hybrid_rational& r)
+		{
+			if (!l._wide && !r._wide)
+			{
+#ifdef __SIZEOF_INT128__
+				return (__int128)l._num * r._denom < (__int128)r._num * l._denom;
+#else
+				long long a, b;
+				if (!detail::multiply_overflows(l._num, r._denom, a) && !detail::multiply_overflows(r._num, l._denom, b)) return a < b;
+#endif
+			}
+			return l.numerator() * r.denominator() < r.numerator() * l.denominator();
+		}
+
+		friend bool operator>(const hybrid_rational& l, const hybrid_rational& r) { return r < l; }
+		friend bool operator<=(const hybrid_rational& l, const hybrid_rational& r) { return !(r < l); }
+		friend bool operator>=(const hybrid_rational& l, const hybrid_rational& r) { return !(l < r); }
+
+		// the largest integer not above r, and the smallest not below it
+		friend Wide floor(const hybrid_rational& r)
+		{
+			Wide n = r.numerator(), d = r.denominator(), q = n / d;
+			if (q * d != n && n < Wide(0)) q -= Wide(1);
+			return q;
+		}
+
+		friend Wide ceil(const hybrid_rational& r)
+		{
+			Wide n = r.numerator(), d = r.denominator(), q = n / d;
+			if (q * d != n && n > Wide(0)) q += Wide(1);
+			return q;
+		}
+
+	private:
+		struct wide_pair
+		{
+			Wide num, denom;
+		};
+
+		void normalize_small()
+		{
+			if (_denom < 0) { _num = -_num; _denom = -_denom; }
+			long long g = num::gcd(_num, _denom);
+			if (g > 1) { _num /= g; _denom /= g; }
+		}
+
+		// reduce, fix the sign and store
+		void set(Wide num, Wide denom)
+		{
+			if (denom < Wide(0)) { num = -num; denom = -denom; }
+			Wide g = num::gcd(num, denom);
+			if (g != Wide(1) && g != Wide(0)) { num /= g; denom /= g; }
+			set_reduced(num, denom);
+		}
+
+		// store a reduced value, small when it fits
+		void set_reduced(const Wide& num, const Wide& denom)
+		{
+			const Wide largest(LLONG_MAX);
+			if (denom <= largest && num <= largest && -largest <= num)
+			{
+				_num = (long long)num;
+				_denom = (long long)denom;
+				_wide.reset();
+			}
+			else
+			{
+				if (!_wide) _wide.reset(new wide_pair);
+				_wide->num = num;
+				_wide->denom = denom;
+			}
+		}
+
+		long long _num, _denom;				// the value while _wide is empty
+		std::unique_ptr<wide_pair> _wide;
+	};
+};
+
+#endif // HYBRID_RATIONAL_H
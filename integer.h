@@ -13,6 +13,8 @@
 
 #include <cassert>
 #include <stdexcept>
+#include <vector>
+#include <cstddef>
 
 namespace num
 {
@@ -130,6 +132,120 @@ namespace num
 	
 	
 	
+	// **************************************************
+	// (a*b) mod m without overflowing the intermediate product.
+	//	native types widen, 128 bit types work in pieces, and any other
+	//	Integer(T) is assumed to be wide enough for the product.
+	template<typename T>
+	//	requires Integer(T) && Positive(m)
+	T multiply_mod(const T& a, const T& b, const T& m)
+	{ return (a*b) % m; }
+	
+	inline int multiply_mod(int a, int b, int m)
+	{ return int((long long)a * b % m); }
+	
+	inline unsigned multiply_mod(unsigned a, unsigned b, unsigned m)
+	{ return unsigned((unsigned long long)a * b % m); }
+	
+#ifdef __SIZEOF_INT128__
+	inline long long multiply_mod(long long a, long long b, long long m)
+	{ return (long long)((__int128)a * b % m); }
+	
+	inline unsigned long long multiply_mod(unsigned long long a, unsigned long long b, unsigned long long m)
+	{ return (unsigned long long)((unsigned __int128)a * b % m); }
+#else
+	inline unsigned long long multiply_mod(unsigned long long a, unsigned long long b, unsigned long long m)
+	{	// double and add.  slow, but never overflows.
+		unsigned long long r = 0;
+		a %= m;
+		while (b)
+		{
+			if (b & 1) r = (r >= m - a) ? r - (m - a) : r + a;
+			a = (a >= m - a) ? a - (m - a) : a + a;
+			b >>= 1;
+		}
+		return r;
+	}
+	
+	inline long long multiply_mod(long long a, long long b, long long m)
+	{
+		bool neg = (a < 0) != (b < 0);
+		unsigned long long r = multiply_mod((unsigned long long)(a < 0 ? -a : a), 
+											(unsigned long long)(b < 0 ? -b : b), 
+											(unsigned long long)m);
+		return neg ? -(long long)r : (long long)r;
+	}
+#endif
+	
+	inline long multiply_mod(long a, long b, long m)
+	{ return (long)multiply_mod((long long)a, (long long)b, (long long)m); }
+	
+	inline unsigned long multiply_mod(unsigned long a, unsigned long b, unsigned long m)
+	{ return (unsigned long)multiply_mod((unsigned long long)a, (unsigned long long)b, (unsigned long long)m); }
+	
+#ifdef __SIZEOF_INT128__
+	// 128 bit operands have no wider native type.  when a and b fit in 64
+	//	bits the product is exact.  otherwise b is taken k bits at a time
+	//	from the top, r = (r 2^k + a chunk) mod m, with k as large as keeps
+	//	that below 2^128; moduli within 8 bits of the top double and add.
+	inline unsigned __int128 multiply_mod(unsigned __int128 a, unsigned __int128 b, unsigned __int128 m)
+	{
+		a %= m;
+		b %= m;
+		if ((a >> 64) == 0 && (b >> 64) == 0) return a * b % m;
+		
+		const unsigned long long high = (unsigned long long)(m >> 64);
+		const int length = high ? 128 - __builtin_clzll(high) : 64 - __builtin_clzll((unsigned long long)m);
+		const int k = 127 - length;
+		unsigned __int128 r = 0;
+		if (k >= 8)
+		{
+			const unsigned long long bh = (unsigned long long)(b >> 64);
+			const int top = bh ? 128 - __builtin_clzll(bh) : 64 - __builtin_clzll((unsigned long long)b);
+			const unsigned __int128 mask = ((unsigned __int128)1 << k) - 1;
+			for (int shift = ((top - 1) / k) * k; shift >= 0; shift -= k)
+			{
+				r = ((r << k) + a * ((b >> shift) & mask)) % m;
+			}
+			return r;
+		}
+		while (b)
+		{
+			if (b & 1) r = (r >= m - a) ? r - (m - a) : r + a;
+			a = (a >= m - a) ? a - (m - a) : a + a;
+			b >>= 1;
+		}
+		return r;
+	}
+	
+	inline __int128 multiply_mod(__int128 a, __int128 b, __int128 m)
+	{
+		bool neg = (a < 0) != (b < 0);
+		unsigned __int128 r = multiply_mod((unsigned __int128)(a < 0 ? -a : a), 
+										   (unsigned __int128)(b < 0 ? -b : b), 
+										   (unsigned __int128)m);
+		return neg ? -(__int128)r : (__int128)r;
+	}
+#endif
+	
+	// multiplication modulo a fixed m, as a binary operation for power()
+	template<typename T>
+	class modular_mult
+	{
+	public:
+		typedef size_t DistanceType;
+		typedef T domain;
+		
+		explicit modular_mult(const T& m) : _m(m) {}
+		
+		T operator()(const T& t1, const T& t2)
+		{ return multiply_mod(t1, t2, _m); }
+		
+		const T& modulus() const { return _m; }
+	private:
+		T _m;
+	};
+	
 	// **************************************************
 	// efficient power computation for binary operations
 	template<typename I, typename Op>
@@ -176,6 +292,156 @@ namespace num
 		if (zero(n)) return a;
 		return power_accumulate_positive(a, op(a, a), n, op);
 	}
+	
+	// the bits of a nonnegative integer, least significant first
+	template<typename I>
+	//	requires Integer(I)
+	std::vector<bool> binary_digits(I n)
+	{
+		assert(positive(n) || zero(n));
+		std::vector<bool> bits;
+		while (!zero(n))
+		{
+			bits.push_back(odd(n));
+			n = half_nonnegative(n);
+		}
+		return bits;
+	}
+	
+	// window width that minimizes precomputation plus multiplications
+	//	for an exponent with the given number of bits
+	inline size_t sliding_window_width(size_t bits)
+	{
+		if (bits <= 8) return 1;
+		if (bits <= 24) return 2;
+		if (bits <= 80) return 3;
+		if (bits <= 240) return 4;
+		if (bits <= 672) return 5;
+		return 6;
+	}
+	
+	// left to right sliding window exponentiation.  precomputes the odd 
+	//	powers a, a^3, ..., a^(2^k - 1) and then spends one multiplication
+	//	per window of up to k bits instead of one per set bit.
+	//	k == 0 picks the width from the size of n.
+	template<typename I, typename Op>
+	//	requires Integer(I) && BinaryOperation(Op)
+	typename Op::domain power_sliding_window(typename Op::domain a, I n, Op op, size_t k = 0)
+	{
+		// precondition: associative(op) && (positive(n) || zero(n))
+		typedef typename Op::domain domain;
+		
+		assert(positive(n) || zero(n));
+		if (zero(n)) return domain(1);
+		
+		std::vector<bool> bits = binary_digits(n);
+		if (k == 0) k = sliding_window_width(bits.size());
+		if (k == 1) return power(a, n, op);
+		
+		std::vector<domain> odd_powers(1, a);
+		domain a2 = op(a, a);
+		for (size_t i = 1; i < (size_t(1) << (k - 1)); ++i)
+		{
+			odd_powers.push_back(op(odd_powers.back(), a2));
+		}
+		
+		bool started = false;
+		domain r = a;
+		size_t i = bits.size();
+		while (i > 0)
+		{
+			if (!bits[i - 1])
+			{
+				r = op(r, r);
+				--i;
+				continue;
+			}
+			// the longest window of at most k bits from bit i-1 that ends in a one
+			size_t low = i > k ? i - k : 0;
+			while (!bits[low]) ++low;
+			size_t value = 0;
+			for (size_t j = i; j > low; --j)
+			{
+				value = (value << 1) | (bits[j - 1] ? 1 : 0);
+				if (started) r = op(r, r);
+			}
+			r = started ? op(r, odd_powers[value >> 1]) : odd_powers[value >> 1];
+			started = true;
+			i = low;
+		}
+		return r;
+	}
+	
+	// powers of a fixed base.  the table holds a^(j * 2^(w*i)) for every
+	//	w-bit digit j and digit position i, so raising the base to an 
+	//	exponent costs one multiplication per nonzero digit and no squarings.
+	//	worthwhile when the same base (a generator, a matrix) is raised to 
+	//	many exponents.
+	template<typename Op>
+	//	requires BinaryOperation(Op)
+	class fixed_base_power
+	{
+	public:
+		typedef typename Op::domain domain;
+		
+		// max_bits bounds the exponents this table can handle; the table
+		//	has ceil(max_bits/w) * (2^w - 1) entries.
+		fixed_base_power(const domain& a, size_t max_bits, size_t w = 4, Op op = Op())
+		: _op(op), _width(w), _digits((max_bits + w - 1) / w)
+		{
+			assert(w > 0 && w < 16);
+			const size_t row = (size_t(1) << w) - 1;
+			_table.reserve(_digits * row);
+			domain base = a;
+			for (size_t i = 0; i < _digits; ++i)
+			{
+				_table.push_back(base);
+				for (size_t j = 1; j < row; ++j)
+				{
+					_table.push_back(_op(_table.back(), base));
+				}
+				// a^(2^(w*(i+1))) = a^((2^w - 1) * 2^(w*i)) * a^(2^(w*i))
+				if (i + 1 < _digits) base = _op(_table.back(), base);
+			}
+		}
+		
+		template<typename I>
+		//	requires Integer(I)
+		domain operator()(I n)
+		{
+			assert(positive(n) || zero(n));
+			const size_t row = (size_t(1) << _width) - 1;
+			
+			bool started = false;
+			domain r = domain(1);
+			for (size_t i = 0; !zero(n); ++i)
+			{
+				size_t digit = 0;
+				for (size_t b = 0; b < _width; ++b)
+				{
+					if (odd(n)) digit |= size_t(1) << b;
+					n = half_nonnegative(n);
+				}
+				if (digit == 0) continue;
+				if (i >= _digits)
+				{
+					throw std::runtime_error("num::fixed_base_power - exponent exceeds the table size.");
+				}
+				const domain& t = _table[i * row + digit - 1];
+				r = started ? _op(r, t) : t;
+				started = true;
+			}
+			return r;
+		}
+		
+		size_t max_bits() const { return _digits * _width; }
+		
+	private:
+		Op _op;
+		size_t _width;
+		size_t _digits;
+		std::vector<domain> _table;
+	};
 }
 
 
@@ -5,37 +5,309 @@
  *  Created by Joe Dumoulin on 10/11/10.
  *  Copyright 2010 __MyCompanyName__. All rights reserved.
  *
+ * floor(sqrt(t)), floor of the k-th root, and perfect square and perfect
+ *	power tests.  Native integers start from the floating point root,
+ *	which is off by at most one, and correct it.  Wider integer types
+ *	use Zimmermann's Karatsuba square root, which costs about as much as
+ *	one division of t by its root.  Anything else falls back to Newton's
+ *	method from above.
  */
 
 #ifndef INTEGER_SQUARE_ROOT
 #define INTEGER_SQUARE_ROOT
 
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <stdexcept>
+#include <stdint.h>
+
 #include "num.h"
-#include "rational.h"
 #include "integer.h"
+#include "gcd.h"
 
 namespace num
 {
+	namespace detail
+	{
+		// native integers, wide integers with shifts and bit_length, and the rest
+		struct native_root_tag {};
+		struct wide_root_tag {};
+		struct newton_root_tag {};
+
+		template<typename T>
+		struct root_category
+		{
+			typedef typename std::conditional<!std::numeric_limits<T>::is_integer, newton_root_tag,
+				typename std::conditional<(std::numeric_limits<T>::digits <= 64), native_root_tag, wide_root_tag>::type>::type type;
+		};
+
+		inline uint64_t square_root64(uint64_t x)
+		{
+			uint64_t r = (uint64_t)std::sqrt((double)x);
+			const uint64_t largest = 0xFFFFFFFFull;	// the largest root of a 64 bit number
+			if (r > largest) r = largest;
+			while (r * r > x) --r;
+			while (r < largest && (r + 1) * (r + 1) <= x) ++r;
+			return r;
+		}
+
+		inline bool power_exceeds64(uint64_t r, unsigned k, uint64_t x)
+		{
+			uint64_t p = 1;
+			for (unsigned i = 0; i < k; ++i)
+			{
+				if (r != 0 && p > x / r) return true;
+				p *= r;
+			}
+			return p > x;
+		}
+
+		inline uint64_t kth_root64(uint64_t x, unsigned k)
+		{
+			if (k == 1 || x < 2) return x;
+			if (k >= 64) return 1;
+			uint64_t r = (uint64_t)std::pow((double)x, 1.0 / k);
+			while (r > 0 && power_exceeds64(r, k, x)) --r;
+			while (!power_exceeds64(r + 1, k, x)) ++r;
+			return r;
+		}
+
+		// s = floor(sqrt(n)) and r = n - s^2 by Zimmermann's recursion.
+		//	with n (shifted left an even amount so that its top quarter
+		//	is at least b/4) = a3 b^3 + a2 b^2 + a1 b + a0 and b = 2^k,
+		//		s', r' = sqrt_rem(a3 b + a2)
+		//		q, u = divide(r' b + a1, 2 s')
+		//		s = s' b + q, r = u b + a0 - q^2
+		//	and s is at most one too large.  no value goes negative, so
+		//	unsigned types work too.
+		template<typename T>
+		void sqrt_rem(const T& n, T& s, T& r)
+		{
+			const int length = bit_length(n);
+			if (length <= 64)
+			{
+				uint64_t x = (uint64_t)n, root = square_root64(x);
+				s = T(root);
+				r = T(x - root * root);
+				return;
+			}
+
+			const int k = (length + 3) / 4;
+			const int c = (4 * k - length) / 2;	// after m = n << 2c, bit_length(m) is 4k or 4k-1
+			const T m = n << (2 * c);
+			const T high = m >> (2 * k);
+			const T middle = m >> k;
+			const T a1 = middle - (high << k);
+			const T a0 = m - (middle << k);
+
+			T s1, r1;
+			sqrt_rem(high, s1, r1);
+			const T numerator = (r1 << k) + a1;
+			const T twice = s1 << 1;
+			const T q = numerator / twice;
+			const T u = numerator - q * twice;
+			s = (s1 << k) + q;
+			const T low = (u << k) + a0, q2 = q * q;
+			if (low >= q2) r = low - q2;
+			else
+			{	// s was one too large: r + 2s - 1 with the old s
+				--s;
+				r = low + (s << 1) + T(1) - q2;
+			}
+
+			if (c > 0)
+			{
+				s = s >> c;
+				r = n - s * s;
+			}
+		}
+
+		template<typename T>
+		T integer_square_root(const T& t, native_root_tag)
+		{
+			return T(square_root64((uint64_t)t));
+		}
+
+		template<typename T>
+		T integer_square_root(const T& t, wide_root_tag)
+		{
+			if (t == T(0)) return t;
+			T s, r;
+			sqrt_rem(t, s, r);
+			return s;
+		}
+
+		template<typename T>
+		T integer_square_root(const T& t, newton_root_tag)
+		{	// the iterates decrease to the root and then stop decreasing
+			T x = t, y = (t + T(1)) / T(2);
+			while (y < x)
+			{
+				x = y;
+				y = (x + t / x) / T(2);
+			}
+			return x;
+		}
+
+		template<typename T>
+		T integer_kth_root(const T& t, unsigned k, native_root_tag)
+		{
+			return T(kth_root64((uint64_t)t, k));
+		}
+
+		// Newton's method from above: x <- ((k-1) x + t/x^(k-1)) / k
+		template<typename T>
+		T newton_kth_root(const T& t, unsigned k, T x)
+		{
+			while (true)
+			{
+				T p(1);
+				for (unsigned i = 1; i < k && p <= t; ++i) p *= x;
+				T y = (T(k - 1) * x + t / p) / T(k);
+				if (!(y < x)) return x;
+				x = y;
+			}
+		}
+
+		template<typename T>
+		T integer_kth_root(const T& t, unsigned k, wide_root_tag)
+		{	// start from 2^ceil(bit_length(t)/k), which is above the root
+			if (t < T(2)) return t;
+			const int length = bit_length(t);
+			if (length <= 64) return T(kth_root64((uint64_t)t, k));
+			return newton_kth_root(t, k, T(1) << int((length + k - 1) / k));
+		}
+
+		template<typename T>
+		T integer_kth_root(const T& t, unsigned k, newton_root_tag)
+		{
+			if (t < T(2)) return t;
+			return newton_kth_root(t, k, t);
+		}
+
+		// which residues are squares modulo 64, 63, 65 and 11.  together
+		//	they pass about one non-square in a hundred.
+		struct square_filter
+		{
+			bool mod64[64], mod63[63], mod65[65], mod11[11];
+
+			square_filter()
+			{
+				for (unsigned i = 0; i < 64; ++i) mod64[i] = false;
+				for (unsigned i = 0; i < 63; ++i) mod63[i] = false;
+				for (unsigned i = 0; i < 65; ++i) mod65[i] = false;
+				for (unsigned i = 0; i < 11; ++i) mod11[i] = false;
+				for (unsigned i = 0; i < 65; ++i)
+				{
+					mod64[i * i % 64] = true;
+					mod63[i * i % 63] = true;
+					mod65[i * i % 65] = true;
+					mod11[i * i % 11] = true;
+				}
+			}
+
+			bool possible(unsigned long r64, unsigned long r45045) const
+			{
+				return mod64[r64] && mod63[r45045 % 63] && mod65[r45045 % 65] && mod11[r45045 % 11];
+			}
+		};
+
+		inline const square_filter& square_residues()
+		{
+			static const square_filter filter;
+			return filter;
+		}
+	}
+
 	template<typename T>
 	// requires Integer(T) && Nonnegative(T)
 	T integer_square_root(const T& t)
-	{	// Use Newton's method to solve n^2 - 4 = 0
-
+	{
 		if (num::negative(t))
 		{
 			throw std::runtime_error("num::integer_square_root - positive only.");
 		}
-		if (t == T(1)) return T(1);
+		return detail::integer_square_root(t, typename detail::root_category<T>::type());
+	}
 
-		T n = t;
-		T nn = t/2;
-	
-		while (absolute_value(nn-n) > T(1))
+	// floor(t^(1/k)) for k >= 1
+	template<typename T>
+	// requires Integer(T) && Nonnegative(T)
+	T integer_kth_root(const T& t, unsigned k)
+	{
+		if (num::negative(t))
 		{
-			n = nn;
-			nn = (n+t/n)/T(2);
+			throw std::runtime_error("num::integer_kth_root - positive only.");
+		}
+		if (k == 0)
+		{
+			throw std::runtime_error("num::integer_kth_root - k must be positive.");
+		}
+		if (k == 1) return t;
+		if (k == 2) return integer_square_root(t);
+		return detail::integer_kth_root(t, k, typename detail::root_category<T>::type());
+	}
+
+	// whether t is a square; the root goes to *root when it is
+	template<typename T>
+	// requires Integer(T)
+	bool is_perfect_square(const T& t, T* root = 0)
+	{
+		if (num::negative(t)) return false;
+		unsigned long r64 = (unsigned long)(t % T(64)), r45045 = (unsigned long)(t % T(45045));
+		if (!detail::square_residues().possible(r64, r45045)) return false;
+		T s = integer_square_root(t);
+		if (s * s != t) return false;
+		if (root) *root = s;
+		return true;
+	}
+
+	// whether t = b^e for some e >= 2.  on success *base gets the
+	//	smallest such b and *exponent the largest e.
+	template<typename T>
+	// requires Integer(T)
+	bool is_perfect_power(const T& t, T* base = 0, unsigned* exponent = 0)
+	{
+		if (t < T(2))
+		{	// 0 = 0^2 and 1 = 1^2
+			if (num::negative(t)) return false;
+			if (base) *base = t;
+			if (exponent) *exponent = 2;
+			return true;
+		}
+
+		T b = t;
+		unsigned e = 1;
+		for (bool found = true; found; )
+		{	// take out prime exponents while there are any
+			found = false;
+			T root;
+			if (is_perfect_square(b, &root))
+			{
+				b = root; e *= 2; found = true;
+				continue;
+			}
+			for (unsigned p = 3; ; p += 2)
+			{
+				bool prime = true;
+				for (unsigned d = 3; d * d <= p; d += 2) if (p % d == 0) { prime = false; break; }
+				if (!prime) continue;
+				root = integer_kth_root(b, p);
+				if (root < T(2)) break;
+				T power(1);
+				for (unsigned i = 0; i < p; ++i) power *= root;
+				if (power == b)
+				{
+					b = root; e *= p; found = true;
+					break;
+				}
+			}
 		}
-		return floor(nn);
+		if (e == 1) return false;
+		if (base) *base = b;
+		if (exponent) *exponent = e;
+		return true;
 	}
 }
 
@@ -4,10 +4,16 @@
  *
  *  Created by Joe Dumoulin on 5/22/11.
  *  Copyright 2011 __MyCompanyName__. All rights reserved.
- *  These functions generate uniform pseudo-random numbers using 
+ *  These functions generate uniform pseudo-random numbers using
  *  linear congruential methods.
  */
 
+#ifndef LINEAR_CONGRUENCE_H
+#define LINEAR_CONGRUENCE_H
+
+#include <vector>
+#include <cstddef>
+
 #include "finite_integral_type.h"
 #include "integer.h"
 
@@ -21,13 +27,123 @@ namespace num
         return seed * multiplier + increment;
     }
 
+    // the affine map x -> multiplier*x + increment.  one step of a linear
+    //  congruential generator is such a map, and so is any number of steps,
+    //  so jumping ahead is just raising the map to a power.
+    template <typename T>
+    // requires Ring(T)
+    struct affine_map
+    {
+        T multiplier;
+        T increment;
+
+        affine_map(const T& a = T(1), const T& c = T(0)) : multiplier(a), increment(c) {}
+
+        T operator()(const T& x) const { return multiplier * x + increment; }
+    };
+
+    // composition of affine maps: apply f, then g.  associative, and the
+    //  identity is affine_map(1), so num::power accepts it.
+    template <typename T>
+    class compose_affine
+    {
+    public:
+        typedef size_t DistanceType;
+        typedef affine_map<T> domain;
+
+        domain operator()(const domain& f, const domain& g)
+        {
+            return domain(g.multiplier * f.multiplier, g.multiplier * f.increment + g.increment);
+        }
+    };
+
+    // the map that advances a generator by step steps, in O(log step)
+    //  multiplications and without any division.
+    template <typename T, typename I>
+    // requires finite_integral_type(T) && Integer(I)
+    affine_map<T> linear_congruential_jump(T multiplier, T increment, I step)
+    {
+        return power(affine_map<T>(multiplier, increment), step, compose_affine<T>());
+    }
+
     template <typename T>
     // requires finite_integral_type(T)
-    // requires multiplier > T(2)
     T linear_congruential_step(T start, T multiplier, T increment, int step)
     {
-        T a_k = num::power(multiplier, step, num::mult());
-        return a_k * start + (a_k - T(1))*increment/(multiplier - T(1));
+        return linear_congruential_jump(multiplier, increment, step)(start);
     }
-    
-};
\ No newline at end of file
+
+    template <typename T>
+    // requires finite_integral_type(T)
+    class linear_congruential_generator
+    {
+    public:
+        typedef T value_type;
+
+        linear_congruential_generator(T seed, T multiplier, T increment)
+        : _state(seed), _step(multiplier, increment) {}
+
+        // the next value in the sequence
+        T operator()()
+        {
+            _state = _step(_state);
+            return _state;
+        }
+
+        // skip n values in O(log n)
+        void discard(unsigned long long n)
+        {
+            if (n > 0) _state = linear_congruential_jump(_step.multiplier, _step.increment, n)(_state);
+        }
+
+        const T& state() const { return _state; }
+
+    private:
+        T _state;
+        affine_map<T> _step;
+    };
+
+    // splits one generator sequence into consecutive, non-overlapping
+    //  substreams of stream_length values each.  stream(k) starts where
+    //  stream(k-1) ends, so handing stream(k) to worker k splits a single
+    //  seed deterministically across any number of threads.
+    template <typename T>
+    // requires finite_integral_type(T)
+    class linear_congruential_streams
+    {
+    public:
+        typedef linear_congruential_generator<T> generator_type;
+
+        linear_congruential_streams(T seed, T multiplier, T increment, unsigned long long stream_length)
+        : _seed(seed), _step(multiplier, increment)
+        , _stride(linear_congruential_jump(multiplier, increment, stream_length))
+        {}
+
+        generator_type stream(unsigned long long k) const
+        {
+            T start = k > 0 ? power(_stride, k, compose_affine<T>())(_seed) : _seed;
+            return generator_type(start, _step.multiplier, _step.increment);
+        }
+
+        // the first n streams, walking the stride once per stream
+        std::vector<generator_type> streams(size_t n) const
+        {
+            std::vector<generator_type> out;
+            T start = _seed;
+            for (size_t k = 0; k < n; ++k)
+            {
+                out.push_back(generator_type(start, _step.multiplier, _step.increment));
+                start = _stride(start);
+            }
+            return out;
+        }
+
+    private:
+        T _seed;
+        affine_map<T> _step;
+        affine_map<T> _stride;
+    };
+
+};
+
+#endif // LINEAR_CONGRUENCE_H
@@ -0,0 +1,333 @@
+/*
+ *  modular_batch.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * Element-wise modular arithmetic over contiguous arrays of residues.
+ *	finite_integral_type carries a vtable and reduces with % on every
+ *	operation; these kernels work on plain uint32_t residues in [0, p)
+ *	for an odd modulus p < 2^31, reduce with Montgomery multiplication
+ *	and use AVX-512 or AVX2 lanes when the compiler targets them
+ *	(-mavx512f / -mavx2).  Define NUM_NO_SIMD to force the scalar code.
+ */
+
+#ifndef MODULAR_BATCH_H
+#define MODULAR_BATCH_H
+
+#include <vector>
+#include <iterator>
+#include <stdexcept>
+#include <cstddef>
+#include <stdint.h>
+
+#if !defined(NUM_NO_SIMD) && (defined(__AVX2__) || defined(__AVX512F__))
+#  include <immintrin.h>
+#endif
+
+namespace num
+{
+	class modular_batch
+	{
+	public:
+		explicit modular_batch(uint32_t p) : _p(p)
+		{
+			if (p < 3 || (p & 1) == 0 || p >= (1u << 31))
+			{
+				throw std::runtime_error("num::modular_batch - modulus must be odd and in [3, 2^31).");
+			}
+			// p^-1 mod 2^32 by Newton's iteration, each step doubles the bits
+			uint32_t inv = p;
+			for (int i = 0; i < 5; ++i) inv *= 2 - p * inv;
+			_p_neg_inv = 0u - inv;
+			_r2 = (uint32_t)((0ULL - p) % p);	// 2^64 mod p
+		}
+
+		uint32_t modulus() const { return _p; }
+
+		// a*b*2^-32 mod p, for a*b < p*2^32
+		uint32_t montgomery(uint32_t a, uint32_t b) const
+		{
+			return reduce((uint64_t)a * b);
+		}
+
+		// a*b mod p
+		uint32_t multiply(uint32_t a, uint32_t b) const
+		{
+			return montgomery(montgomery(a, b), _r2);
+		}
+
+		// out[i] = a[i] + b[i] mod p
+		void add(const uint32_t* a, const uint32_t* b, uint32_t* out, size_t n) const
+		{
+			size_t i = 0;
+#if !defined(NUM_NO_SIMD) && defined(__AVX512F__)
+			const __m512i p16 = _mm512_set1_epi32((int)_p);
+			for (; i + 16 <= n; i += 16)
+			{
+				__m512i s = _mm512_add_epi32(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+				_mm512_storeu_si512(out + i, _mm512_min_epu32(s, _mm512_sub_epi32(s, p16)));
+			}
+#endif
+#if !defined(NUM_NO_SIMD) && defined(__AVX2__)
+			const __m256i p8 = _mm256_set1_epi32((int)_p);
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256i s = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(a + i)),
+											 _mm256_loadu_si256((const __m256i*)(b + i)));
+				_mm256_storeu_si256((__m256i*)(out + i), _mm256_min_epu32(s, _mm256_sub_epi32(s, p8)));
+			}
+#endif
+			for (; i < n; ++i)
+			{
+				uint32_t s = a[i] + b[i];
+				out[i] = s >= _p ? s - _p : s;
+			}
+		}
+
+		// out[i] = a[i] * b[i] mod p
+		void multiply(const uint32_t* a, const uint32_t* b, uint32_t* out, size_t n) const
+		{
+			size_t i = 0;
+#if !defined(NUM_NO_SIMD) && defined(__AVX512F__)
+			const __m512i r2_16 = _mm512_set1_epi32((int)_r2);
+			for (; i + 16 <= n; i += 16)
+			{
+				__m512i t = montgomery16(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+				_mm512_storeu_si512(out + i, montgomery16(t, r2_16));
+			}
+#endif
+#if !defined(NUM_NO_SIMD) && defined(__AVX2__)
+			const __m256i r2_8 = _mm256_set1_epi32((int)_r2);
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256i t = montgomery8(_mm256_loadu_si256((const __m256i*)(a + i)),
+										_mm256_loadu_si256((const __m256i*)(b + i)));
+				_mm256_storeu_si256((__m256i*)(out + i), montgomery8(t, r2_8));
+			}
+#endif
+			for (; i < n; ++i)
+			{
+				out[i] = multiply(a[i], b[i]);
+			}
+		}
+
+		// out[i] = s * a[i] mod p
+		void scale(uint32_t s, const uint32_t* a, uint32_t* out, size_t n) const
+		{
+			// s in montgomery form cancels the 2^-32 of a single reduction
+			const uint32_t sr = montgomery(s % _p, _r2);
+			size_t i = 0;
+#if !defined(NUM_NO_SIMD) && defined(__AVX512F__)
+			const __m512i s16 = _mm512_set1_epi32((int)sr);
+			for (; i + 16 <= n; i += 16)
+			{
+				_mm512_storeu_si512(out + i, montgomery16(_mm512_loadu_si512(a + i), s16));
+			}
+#endif
+#if !defined(NUM_NO_SIMD) && defined(__AVX2__)
+			const __m256i s8 = _mm256_set1_epi32((int)sr);
+			for (; i + 8 <= n; i += 8)
+			{
+				_mm256_storeu_si256((__m256i*)(out + i),
+									montgomery8(_mm256_loadu_si256((const __m256i*)(a + i)), s8));
+			}
+#endif
+			for (; i < n; ++i)
+			{
+				out[i] = montgomery(a[i], sr);
+			}
+		}
+
+		// out[i] = a[i] * b[i] + c[i] mod p
+		void multiply_add(const uint32_t* a, const uint32_t* b, const uint32_t* c, uint32_t* out, size_t n) const
+		{
+			size_t i = 0;
+#if !defined(NUM_NO_SIMD) && defined(__AVX512F__)
+			const __m512i p16 = _mm512_set1_epi32((int)_p);
+			const __m512i r2_16 = _mm512_set1_epi32((int)_r2);
+			for (; i + 16 <= n; i += 16)
+			{
+				__m512i t = montgomery16(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+				__m512i s = _mm512_add_epi32(montgomery16(t, r2_16), _mm512_loadu_si512(c + i));
+				_mm512_storeu_si512(out + i, _mm512_min_epu32(s, _mm512_sub_epi32(s, p16)));
+			}
+#endif
+#if !defined(NUM_NO_SIMD) && defined(__AVX2__)
+			const __m256i p8 = _mm256_set1_epi32((int)_p);
+			const __m256i r2_8 = _mm256_set1_epi32((int)_r2);
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256i t = montgomery8(_mm256_loadu_si256((const __m256i*)(a + i)),
+										_mm256_loadu_si256((const __m256i*)(b + i)));
+				__m256i s = _mm256_add_epi32(montgomery8(t, r2_8), _mm256_loadu_si256((const __m256i*)(c + i)));
+				_mm256_storeu_si256((__m256i*)(out + i), _mm256_min_epu32(s, _mm256_sub_epi32(s, p8)));
+			}
+#endif
+			for (; i < n; ++i)
+			{
+				uint32_t s = multiply(a[i], b[i]) + c[i];
+				out[i] = s >= _p ? s - _p : s;
+			}
+		}
+
+		// sum of a[i] * b[i] mod p
+		uint32_t dot(const uint32_t* a, const uint32_t* b, size_t n) const
+		{
+			// each reduced term is < p < 2^31, so 64 bit lane sums
+			//	cannot overflow for any array that fits in memory.
+			uint64_t sum = 0;
+			size_t i = 0;
+#if !defined(NUM_NO_SIMD) && defined(__AVX512F__)
+			__m512i acc16 = _mm512_setzero_si512();
+			for (; i + 16 <= n; i += 16)
+			{
+				__m512i t = montgomery16(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+				acc16 = _mm512_add_epi64(acc16, _mm512_and_si512(t, _mm512_set1_epi64(0xFFFFFFFF)));
+				acc16 = _mm512_add_epi64(acc16, _mm512_srli_epi64(t, 32));
+			}
+			sum += (uint64_t)_mm512_reduce_add_epi64(acc16);
+#endif
+#if !defined(NUM_NO_SIMD) && defined(__AVX2__)
+			__m256i acc8 = _mm256_setzero_si256();
+			const __m256i low = _mm256_set1_epi64x(0xFFFFFFFF);
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256i t = montgomery8(_mm256_loadu_si256((const __m256i*)(a + i)),
+										_mm256_loadu_si256((const __m256i*)(b + i)));
+				acc8 = _mm256_add_epi64(acc8, _mm256_and_si256(t, low));
+				acc8 = _mm256_add_epi64(acc8, _mm256_srli_epi64(t, 32));
+			}
+			uint64_t lanes[4];
+			_mm256_storeu_si256((__m256i*)lanes, acc8);
+			sum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+			for (; i < n; ++i)
+			{
+				sum += montgomery(a[i], b[i]);
+			}
+			// every term carried a factor 2^-32
+			return montgomery((uint32_t)(sum % _p), _r2);
+		}
+
+		// std::vector conveniences
+		std::vector<uint32_t> add(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) const
+		{
+			check_sizes(a.size(), b.size());
+			std::vector<uint32_t> out(a.size());
+			add(data(a), data(b), data(out), a.size());
+			return out;
+		}
+
+		std::vector<uint32_t> multiply(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) const
+		{
+			check_sizes(a.size(), b.size());
+			std::vector<uint32_t> out(a.size());
+			multiply(data(a), data(b), data(out), a.size());
+			return out;
+		}
+
+		std::vector<uint32_t> scale(uint32_t s, const std::vector<uint32_t>& a) const
+		{
+			std::vector<uint32_t> out(a.size());
+			scale(s, data(a), data(out), a.size());
+			return out;
+		}
+
+		uint32_t dot(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) const
+		{
+			check_sizes(a.size(), b.size());
+			return dot(data(a), data(b), a.size());
+		}
+
+	private:
+		uint32_t reduce(uint64_t t) const
+		{
+			uint32_t m = (uint32_t)t * _p_neg_inv;
+			uint32_t r = (uint32_t)((t + (uint64_t)m * _p) >> 32);
+			return r >= _p ? r - _p : r;
+		}
+
+		static void check_sizes(size_t a, size_t b)
+		{
+			if (a != b)
+			{
+				throw std::runtime_error("num::modular_batch - array sizes differ.");
+			}
+		}
+
+		static const uint32_t* data(const std::vector<uint32_t>& v) { return v.empty() ? 0 : &v[0]; }
+		static uint32_t* data(std::vector<uint32_t>& v) { return v.empty() ? 0 : &v[0]; }
+
+#if !defined(NUM_NO_SIMD) && defined(__AVX2__)
+		// montgomery reduction of the 64 bit products in the even lanes.
+		//	the result is left in the high half of each 64 bit lane.
+		__m256i reduce_even8(__m256i t) const
+		{
+			const __m256i p = _mm256_set1_epi64x(_p);
+			const __m256i q = _mm256_set1_epi64x(_p_neg_inv);
+			__m256i m = _mm256_mul_epu32(t, q);	// low 32 bits of t * -p^-1
+			return _mm256_add_epi64(t, _mm256_mul_epu32(m, p));
+		}
+
+		__m256i montgomery8(__m256i a, __m256i b) const
+		{
+			__m256i even = reduce_even8(_mm256_mul_epu32(a, b));
+			__m256i odd = reduce_even8(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)));
+			__m256i r = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+			return _mm256_min_epu32(r, _mm256_sub_epi32(r, _mm256_set1_epi32((int)_p)));
+		}
+#endif
+
+#if !defined(NUM_NO_SIMD) && defined(__AVX512F__)
+		__m512i reduce_even16(__m512i t) const
+		{
+			const __m512i p = _mm512_set1_epi64(_p);
+			const __m512i q = _mm512_set1_epi64(_p_neg_inv);
+			__m512i m = _mm512_mul_epu32(t, q);
+			return _mm512_add_epi64(t, _mm512_mul_epu32(m, p));
+		}
+
+		__m512i montgomery16(__m512i a, __m512i b) const
+		{
+			__m512i even = reduce_even16(_mm512_mul_epu32(a, b));
+			__m512i odd = reduce_even16(_mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32)));
+			__m512i r = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd);
+			return _mm512_min_epu32(r, _mm512_sub_epi32(r, _mm512_set1_epi32((int)_p)));
+		}
+#endif
+
+		uint32_t _p;
+		uint32_t _p_neg_inv;	// -p^-1 mod 2^32
+		uint32_t _r2;			// 2^64 mod p
+	};
+
+	// copy the canonical residues of a range of finite_integral_type into
+	//	a plain array the kernels can use, and back again.
+	template<typename I>
+	// requires InputIterator(I) && finite_integral_type(ValueType(I))
+	std::vector<uint32_t> to_residues(I begin, I end)
+	{
+		std::vector<uint32_t> out;
+		for (; begin != end; ++begin)
+		{
+			long long v = (long long)begin->value() % (long long)begin->base();
+			if (v < 0) v += (long long)begin->base();
+			out.push_back((uint32_t)v);
+		}
+		return out;
+	}
+
+	template<typename FIT, typename Container>
+	void from_residues(const std::vector<uint32_t>& residues, std::back_insert_iterator<Container> out)
+	{
+		typedef typename FIT::value_type value_type;
+		for (size_t i = 0; i < residues.size(); ++i)
+		{
+			out++ = FIT(value_type(residues[i]));
+		}
+	}
+};
+
+#endif // MODULAR_BATCH_H
@@ -0,0 +1,188 @@
+/*
+ *  multiplicative_functions.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * Multiplicative arithmetic functions: Euler's totient phi, Mobius mu,
+ *	the divisor count d and the divisor sums sigma_k.  Single values
+ *	come from the prime factorization.  Ranges are sieved a block at a
+ *	time: every prime up to sqrt(hi) visits its multiples in the block,
+ *	and whatever cofactor is left is a single large prime.  Blocks are
+ *	handed to the caller one by one, so ranges larger than memory only
+ *	ever hold one block.
+ */
+
+#ifndef MULTIPLICATIVE_FUNCTIONS_H
+#define MULTIPLICATIVE_FUNCTIONS_H
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
+#include <stdint.h>
+
+#include "integer.h"
+#include "prime_factors.h"
+#include "prime_sieve.h"
+
+namespace num
+{
+	// the value of each function at a prime power p^e (e >= 1)
+	template<typename T>
+	struct totient_of_prime_power
+	{
+		T operator()(uint64_t p, unsigned e) const
+		{
+			T r = T(p) - T(1);
+			for (unsigned i = 1; i < e; ++i) r *= T(p);
+			return r;
+		}
+	};
+
+	template<typename T>
+	struct mobius_of_prime_power
+	{
+		T operator()(uint64_t, unsigned e) const { return e == 1 ? T(-1) : T(0); }
+	};
+
+	template<typename T>
+	struct divisor_count_of_prime_power
+	{
+		T operator()(uint64_t, unsigned e) const { return T(e + 1); }
+	};
+
+	template<typename T>
+	struct divisor_sum_of_prime_power
+	{
+		unsigned k;
+		explicit divisor_sum_of_prime_power(unsigned power = 1) : k(power) {}
+
+		// 1 + p^k + p^2k + ... + p^ek
+		T operator()(uint64_t p, unsigned e) const
+		{
+			T pk = power(T(p), k, mult<T>());
+			T term = T(1), sum = T(1);
+			for (unsigned i = 0; i < e; ++i)
+			{
+				term *= pk;
+				sum += term;
+			}
+			return sum;
+		}
+	};
+
+	// f(n) for a multiplicative f given by its value at prime powers
+	template<typename T, typename PrimePower>
+	T multiplicative_function(uint64_t n, PrimePower f)
+	{
+		if (n == 0)
+		{
+			throw std::runtime_error("num::multiplicative_function - undefined at zero.");
+		}
+		std::vector<uint64_t> factors;
+		prime_factors(n, std::back_inserter(factors));
+		std::sort(factors.begin(), factors.end());
+
+		T r = T(1);
+		for (size_t i = 0; i < factors.size(); )
+		{
+			uint64_t p = factors[i];
+			unsigned e = 0;
+			for (; i < factors.size() && factors[i] == p; ++i) ++e;
+			if (p > 1) r *= f(p, e);
+		}
+		return r;
+	}
+
+	template<typename T>
+	T euler_totient(uint64_t n) { return multiplicative_function<T>(n, totient_of_prime_power<T>()); }
+
+	template<typename T>
+	T mobius(uint64_t n) { return multiplicative_function<T>(n, mobius_of_prime_power<T>()); }
+
+	template<typename T>
+	T divisor_count(uint64_t n) { return multiplicative_function<T>(n, divisor_count_of_prime_power<T>()); }
+
+	template<typename T>
+	T divisor_sum(uint64_t n, unsigned k = 1) { return multiplicative_function<T>(n, divisor_sum_of_prime_power<T>(k)); }
+
+	// segmented mode.  computes f(n) for lo <= n <= hi, block_size values
+	//	at a time, and calls visit(first_n, values) for each block where
+	//	values[i] == f(first_n + i).  memory is O(block_size + sqrt(hi)).
+	template<typename T, typename PrimePower, typename Visit>
+	void multiplicative_sieve(uint64_t lo, uint64_t hi, PrimePower f, Visit visit, size_t block_size = 1 << 20)
+	{
+		if (lo == 0) lo = 1;
+		if (lo > hi) return;
+		if (block_size == 0) block_size = 1;
+
+		std::vector<uint64_t> primes;
+		uint64_t root = detail::floor_square_root(hi);
+		prime_sieve(root).primes(0, root, std::back_inserter(primes));
+
+		std::vector<T> values;
+		std::vector<uint64_t> rest;
+		for (uint64_t first = lo; ; first += block_size)
+		{
+			const uint64_t last = std::min<uint64_t>(hi, first + block_size - 1);
+			const size_t n = (size_t)(last - first + 1);
+			values.assign(n, T(1));
+			rest.resize(n);
+			for (size_t i = 0; i < n; ++i) rest[i] = first + i;
+
+			for (size_t j = 0; j < primes.size(); ++j)
+			{
+				const uint64_t p = primes[j];
+				if (p * p > last) break;
+				for (uint64_t m = (first + p - 1) / p * p; m <= last; m += p)
+				{
+					const size_t i = (size_t)(m - first);
+					unsigned e = 0;
+					uint64_t r = rest[i];
+					do { r /= p; ++e; } while (r % p == 0);
+					rest[i] = r;
+					values[i] *= f(p, e);
+				}
+			}
+			// at most one prime above sqrt(n) divides n
+			for (size_t i = 0; i < n; ++i)
+			{
+				if (rest[i] > 1) values[i] *= f(rest[i], 1);
+			}
+
+			visit(first, values);
+			if (last == hi) break;
+		}
+	}
+
+	// f(n) for lo <= n <= hi, all in memory
+	template<typename T, typename PrimePower>
+	std::vector<T> multiplicative_range(uint64_t lo, uint64_t hi, PrimePower f)
+	{
+		std::vector<T> all;
+		multiplicative_sieve<T>(lo, hi, f,
+			[&all](uint64_t, const std::vector<T>& values) { all.insert(all.end(), values.begin(), values.end()); });
+		return all;
+	}
+
+	template<typename T>
+	std::vector<T> euler_totient_range(uint64_t lo, uint64_t hi)
+	{ return multiplicative_range<T>(lo, hi, totient_of_prime_power<T>()); }
+
+	template<typename T>
+	std::vector<T> mobius_range(uint64_t lo, uint64_t hi)
+	{ return multiplicative_range<T>(lo, hi, mobius_of_prime_power<T>()); }
+
+	template<typename T>
+	std::vector<T> divisor_count_range(uint64_t lo, uint64_t hi)
+	{ return multiplicative_range<T>(lo, hi, divisor_count_of_prime_power<T>()); }
+
+	template<typename T>
+	std::vector<T> divisor_sum_range(uint64_t lo, uint64_t hi, unsigned k = 1)
+	{ return multiplicative_range<T>(lo, hi, divisor_sum_of_prime_power<T>(k)); }
+};
+
+#endif // MULTIPLICATIVE_FUNCTIONS_H
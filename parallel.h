@@ -0,0 +1,171 @@
+/*
+ *  parallel.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * Small helpers for splitting a numeric job across threads, and a
+ *	thread pool for jobs that are not all known up front.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <cstddef>
+#include <stdint.h>
+
+namespace num
+{
+	inline unsigned hardware_threads()
+	{
+		unsigned n = std::thread::hardware_concurrency();
+		return n > 0 ? n : 1;
+	}
+
+	// split [begin, end) into at most threads contiguous chunks, each a
+	//	multiple of grain long (except the last), and call
+	//	f(chunk_begin, chunk_end, thread_index) for each on its own thread.
+	//	the calling thread runs the first chunk.
+	template<typename I, typename F>
+	// requires Integer(I)
+	void parallel_for_chunks(I begin, I end, unsigned threads, F f, I grain = I(1))
+	{
+		if (!(begin < end)) return;
+		if (threads == 0) threads = hardware_threads();
+
+		I grains = (end - begin + grain - I(1)) / grain;
+		if (I(threads) > grains) threads = unsigned(grains);
+		I per_thread = (grains + I(threads) - I(1)) / I(threads) * grain;
+
+		std::vector<std::thread> workers;
+		for (unsigned t = 1; t < threads; ++t)
+		{
+			I lo = begin + per_thread * I(t);
+			if (!(lo < end)) break;
+			I hi = (end - lo > per_thread) ? lo + per_thread : end;
+			workers.push_back(std::thread(f, lo, hi, t));
+		}
+		f(begin, (end - begin > per_thread) ? begin + per_thread : end, 0u);
+		for (size_t i = 0; i < workers.size(); ++i) workers[i].join();
+	}
+
+	// a fixed set of worker threads running submitted jobs in order.
+	//	a job must not wait on a job submitted after it.
+	class thread_pool
+	{
+	public:
+		explicit thread_pool(unsigned threads = 0) : _stop(false)
+		{
+			if (threads == 0) threads = hardware_threads();
+			for (unsigned t = 0; t < threads; ++t) _workers.push_back(std::thread(&thread_pool::work, this));
+		}
+
+		~thread_pool()
+		{
+			{
+				std::lock_guard<std::mutex> guard(_lock);
+				_stop = true;
+			}
+			_ready.notify_all();
+			for (size_t i = 0; i < _workers.size(); ++i) _workers[i].join();
+		}
+
+		unsigned size() const { return unsigned(_workers.size()); }
+
+		// run f() on some worker; the future holds its result
+		template<typename F>
+		std::future<decltype(std::declval<F>()())> submit(F f)
+		{
+			typedef decltype(f()) result_type;
+			std::shared_ptr<std::packaged_task<result_type()> > task(new std::packaged_task<result_type()>(f));
+			{
+				std::lock_guard<std::mutex> guard(_lock);
+				_jobs.push_back([task]() { (*task)(); });
+			}
+			_ready.notify_one();
+			return task->get_future();
+		}
+
+	private:
+		thread_pool(const thread_pool&);
+		thread_pool& operator=(const thread_pool&);
+
+		void work()
+		{
+			while (true)
+			{
+				std::function<void()> job;
+				{
+					std::unique_lock<std::mutex> guard(_lock);
+					_ready.wait(guard, [this]() { return _stop || !_jobs.empty(); });
+					if (_jobs.empty()) return;
+					job = _jobs.front();
+					_jobs.pop_front();
+				}
+				job();
+			}
+		}
+
+		std::vector<std::thread> _workers;
+		std::deque<std::function<void()> > _jobs;
+		std::mutex _lock;
+		std::condition_variable _ready;
+		bool _stop;
+	};
+
+	// a pool of threads workers (0 for all of them) in holder when there
+	//	is at least minimum work to share, and no pool otherwise
+	inline thread_pool* pool_for(std::unique_ptr<thread_pool>& holder, uint64_t work, uint64_t minimum, unsigned threads)
+	{
+		if (threads == 0) threads = hardware_threads();
+		if (threads > 1 && work >= minimum) holder.reset(new thread_pool(threads));
+		return holder.get();
+	}
+
+	// n leaves combined over a balanced tree by an associative combine.
+	//	leaf(lo, hi) reduces [lo, hi) on the calling thread.  with a pool
+	//	and at least 2 grain leaves, ranges of grain or more leaves run as
+	//	jobs, and then the partial results are paired one level at a time.
+	template<typename T, typename Leaf, typename Combine>
+	T parallel_tree_reduce(size_t n, Leaf leaf, Combine combine, thread_pool* pool, size_t grain)
+	{
+		if (pool == 0 || pool->size() < 2 || n < 2 * grain) return leaf(size_t(0), n);
+
+		size_t chunks = 4 * pool->size();
+		if (chunks > n / grain) chunks = n / grain;
+		std::vector<std::future<T> > jobs;
+		for (size_t c = 0; c < chunks; ++c)
+		{
+			size_t lo = n * c / chunks, hi = n * (c + 1) / chunks;
+			jobs.push_back(pool->submit([&leaf, lo, hi]() { return leaf(lo, hi); }));
+		}
+		std::vector<T> level;
+		for (size_t i = 0; i < jobs.size(); ++i) level.push_back(jobs[i].get());
+
+		while (level.size() > 1)
+		{
+			jobs.clear();
+			for (size_t i = 0; i + 1 < level.size(); i += 2)
+			{
+				jobs.push_back(pool->submit([&level, &combine, i]() { return combine(level[i], level[i + 1]); }));
+			}
+			std::vector<T> up;
+			for (size_t i = 0; i < jobs.size(); ++i) up.push_back(jobs[i].get());
+			if (level.size() % 2) up.push_back(level.back());
+			level.swap(up);
+		}
+		return level[0];
+	}
+};
+
+#endif // PARALLEL_H
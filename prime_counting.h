@@ -0,0 +1,151 @@
+/*
+ *  prime_counting.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * pi(x) and the sum of the primes up to x without listing them, using
+ *	Lucy Hedgehog's variant of the Legendre/Meissel sieve.  S(v) starts
+ *	as the count (or sum) of 2..v and each prime p <= sqrt(x) removes
+ *	the numbers whose smallest factor is p.  Only the O(sqrt(x)) values
+ *	v = x/i are ever needed, so memory stays at a few arrays of sqrt(x)
+ *	entries.  Each prime's update pass is split between threads.
+ */
+
+#ifndef PRIME_COUNTING_H
+#define PRIME_COUNTING_H
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+#include "parallel.h"
+#include "prime_sieve.h"
+
+namespace num
+{
+	namespace detail
+	{
+		// n/p from a floating point reciprocal with one correction step;
+		//	much cheaper than a 64 bit division for n < 2^53.
+		inline uint64_t divide(uint64_t n, uint64_t p, double inverse)
+		{
+			uint64_t q = (uint64_t)((double)n * inverse);
+			if (q * p > n) --q;
+			else if ((q + 1) * p <= n) ++q;
+			return q;
+		}
+
+		// Lucy's sieve.  Initial gives S(v) before sieving (the weighted
+		//	count of 2..v) and Weight gives each prime's weight (1 to
+		//	count primes, p to sum them).
+		template<typename Acc, typename Initial, typename Weight>
+		Acc lucy_hedgehog(uint64_t x, Initial initial, Weight weight, unsigned threads)
+		{
+			if (x < 2) return Acc(0);
+			if (threads == 0) threads = hardware_threads();
+
+			const uint64_t r = floor_square_root(x);
+			// small[v] = S(v) for v <= r,  large[i] = S(x/i) for i <= r
+			std::vector<Acc> small(r + 1), large(r + 1), delta(r + 1);
+			std::vector<uint64_t> quotient(r + 1);	// x/i
+			for (uint64_t v = 1; v <= r; ++v)
+			{
+				quotient[v] = x / v;
+				small[v] = initial(v);
+				large[v] = initial(quotient[v]);
+			}
+
+			// below this many updates a pass is not worth a thread
+			const uint64_t grain = 1 << 15;
+
+			for (uint64_t p = 2; p <= r; ++p)
+			{
+				if (small[p] == small[p - 1]) continue;	// p is not prime
+				const Acc sp = small[p - 1];
+				const Acc wp = weight(p);
+				const uint64_t p2 = p * p;
+				const uint64_t large_end = std::min<uint64_t>(r, x / p2);
+				const double inverse = 1.0 / (double)p;
+
+				// S(x/i) -= w(p) * (S(x/(i p)) - S(p-1)).  every update reads
+				//	values from before this pass, so compute all the deltas
+				//	first and apply them after.
+				auto large_pass = [&](uint64_t first, uint64_t end, unsigned)
+				{
+					for (uint64_t i = first; i < end; ++i)
+					{
+						const uint64_t d = i * p;
+						const Acc s = d <= r ? large[d] : small[divide(quotient[i], p, inverse)];
+						delta[i] = wp * (s - sp);
+					}
+				};
+				if (large_end >= grain && threads > 1)
+					parallel_for_chunks<uint64_t>(1, large_end + 1, threads, large_pass, grain);
+				else
+					large_pass(1, large_end + 1, 0);
+				for (uint64_t i = 1; i <= large_end; ++i) large[i] -= delta[i];
+
+				// S(v) -= w(p) * (S(v/p) - S(p-1)) for p^2 <= v <= r
+				if (p2 > r) continue;
+				auto small_pass = [&](uint64_t first, uint64_t end, unsigned)
+				{
+					for (uint64_t v = first; v < end; ++v)
+					{
+						delta[v] = wp * (small[divide(v, p, inverse)] - sp);
+					}
+				};
+				if (r - p2 >= grain && threads > 1)
+					parallel_for_chunks<uint64_t>(p2, r + 1, threads, small_pass, grain);
+				else
+					small_pass(p2, r + 1, 0);
+				for (uint64_t v = p2; v <= r; ++v) small[v] -= delta[v];
+			}
+			return large[1];
+		}
+
+		struct count_from_two
+		{
+			uint64_t operator()(uint64_t v) const { return v - 1; }
+		};
+
+		struct unit_weight
+		{
+			uint64_t operator()(uint64_t) const { return 1; }
+		};
+
+		template<typename Acc>
+		struct sum_from_two
+		{	// 2 + 3 + ... + v
+			Acc operator()(uint64_t v) const
+			{
+				Acc a(v), b(v + 1);
+				return (v & 1) ? a * (b / Acc(2)) - Acc(1) : (a / Acc(2)) * b - Acc(1);
+			}
+		};
+
+		template<typename Acc>
+		struct prime_weight
+		{
+			Acc operator()(uint64_t p) const { return Acc(p); }
+		};
+	}
+
+	// the number of primes p <= x.  O(x^(3/4)) time, O(sqrt(x)) memory.
+	//	x must be below 2^53.
+	inline uint64_t prime_count(uint64_t x, unsigned threads = 0)
+	{
+		return detail::lucy_hedgehog<uint64_t>(x, detail::count_from_two(), detail::unit_weight(), threads);
+	}
+
+	// the sum of the primes p <= x.  Acc must hold about x^2/2; for x
+	//	past 6*10^9 that means unsigned __int128 or a wide integer.
+	template<typename Acc>
+	Acc prime_sum(uint64_t x, unsigned threads = 0)
+	{
+		return detail::lucy_hedgehog<Acc>(x, detail::sum_from_two<Acc>(), detail::prime_weight<Acc>(), threads);
+	}
+};
+
+#endif // PRIME_COUNTING_H
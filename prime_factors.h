@@ -14,11 +14,15 @@
 #include <vector>
 #include <iterator>
 #include <stdexcept>
+#include <limits>
+#include <algorithm>
 
 #include "num.h"
 #include "integer.h"
 #include "integer_square_root.h"
 #include "gcd.h"
+#include "prime_sieve.h"
+#include "ecm.h"
 
 namespace num
 {
@@ -39,25 +43,357 @@ namespace num
 		}
 	}
 	
+	// deterministic Miller-Rabin for 64 bit integers.  these seven bases
+	//	have no common strong pseudoprime below 2^64 (Jim Sinclair).
+	inline bool miller_rabin(unsigned long long n)
+	{
+		static const unsigned long long small[] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 };
+		static const unsigned long long bases[] = { 2, 325, 9375, 28178, 450775, 9780504, 1795265022 };
+		
+		if (n < 2) return false;
+		for (size_t i = 0; i < sizeof(small)/sizeof(small[0]); ++i)
+		{
+			if (n % small[i] == 0) return n == small[i];
+		}
+		if (n < 37*37) return true;
+		
+		// n - 1 = d * 2^s with d odd
+		unsigned long long d = n - 1;
+		int s = 0;
+		while (even(d)) { d >>= 1; ++s; }
+		
+		modular_mult<unsigned long long> op(n);
+		for (size_t i = 0; i < sizeof(bases)/sizeof(bases[0]); ++i)
+		{
+			unsigned long long a = bases[i] % n;
+			if (a == 0) continue;
+			
+			unsigned long long x = power(a, d, op);
+			if (x == 1 || x == n - 1) continue;
+			
+			int r = 1;
+			for (; r < s; ++r)
+			{
+				x = op(x, x);
+				if (x == n - 1) break;
+			}
+			if (r == s) return false;	// a witnesses that n is composite
+		}
+		return true;
+	}
+	
+	namespace detail
+	{
+		template<bool NATIVE> struct native_integer_tag {};
+		
+		template<typename T>
+		bool probable_prime(const T& n);
+		
+		template<typename T>
+		bool is_prime(const T& t, native_integer_tag<true>)
+		{
+			if (t < T(2)) return false;
+			return miller_rabin((unsigned long long)t);
+		}
+		
+		// strong probable prime tests through multiply_mod, which covers
+		//	wide types too
+		template<typename T>
+		bool is_prime(const T& t, native_integer_tag<false>)
+		{
+			if (t < T(2)) return false;
+			return probable_prime(t);
+		}
+	}
+	
 	template<typename T>
-	// requires Positive(T)
+	// requires Integer(T)
 	bool is_prime(const T& t)
 	{
-		if (t == T(1)) return true; // 1 is prime
-		T d = integer_square_root(t);
+		return detail::is_prime(t, detail::native_integer_tag<std::numeric_limits<T>::is_integer
+								&& std::numeric_limits<T>::digits <= 64>());
+	}
+
+	namespace detail
+	{
+#ifdef __SIZEOF_INT128__
+		// montgomery arithmetic modulo an odd 64 bit n.  values stay in
+		//	montgomery form (x*2^64 mod n) so a product costs two 64x64
+		//	multiplications instead of a 128 bit division.
+		class modular_arithmetic64
+		{
+		public:
+			explicit modular_arithmetic64(unsigned long long n) : _n(n)
+			{
+				_inv = n;	// n^-1 mod 2^64 by Newton's iteration
+				for (int i = 0; i < 6; ++i) _inv *= 2 - n * _inv;
+				unsigned long long r = (0ULL - n) % n;	// 2^64 mod n
+				_r2 = (unsigned long long)((unsigned __int128)r * r % n);
+			}
+			
+			unsigned long long to(unsigned long long x) const { return multiply(x % _n, _r2); }
+			unsigned long long from(unsigned long long x) const { return reduce(x); }
+			
+			unsigned long long multiply(unsigned long long a, unsigned long long b) const
+			{
+				return reduce((unsigned __int128)a * b);
+			}
+			
+			unsigned long long add(unsigned long long a, unsigned long long b) const
+			{
+				return a >= _n - b ? a - (_n - b) : a + b;
+			}
+			
+			unsigned long long modulus() const { return _n; }
+			
+		private:
+			unsigned long long reduce(unsigned __int128 t) const
+			{	// t * 2^-64 mod n, written so that it cannot overflow for n near 2^64
+				unsigned long long m = (unsigned long long)t * _inv;
+				unsigned long long mn = (unsigned long long)(((unsigned __int128)m * _n) >> 64);
+				unsigned long long hi = (unsigned long long)(t >> 64);
+				return hi >= mn ? hi - mn : hi + (_n - mn);
+			}
+			
+			unsigned long long _n;
+			unsigned long long _inv;
+			unsigned long long _r2;
+		};
+#else
+		class modular_arithmetic64
+		{
+		public:
+			explicit modular_arithmetic64(unsigned long long n) : _n(n) {}
+			unsigned long long to(unsigned long long x) const { return x % _n; }
+			unsigned long long from(unsigned long long x) const { return x; }
+			unsigned long long multiply(unsigned long long a, unsigned long long b) const
+			{ return multiply_mod(a, b, _n); }
+			unsigned long long add(unsigned long long a, unsigned long long b) const
+			{ return a >= _n - b ? a - (_n - b) : a + b; }
+			unsigned long long modulus() const { return _n; }
+		private:
+			unsigned long long _n;
+		};
+#endif
 		
-		while (t % d != T(0) && t > T(1)) --d;
-		if (d == T(1)) 
+		// primes below 2^10 for trial division ahead of rho
+		inline const std::vector<uint32_t>& trial_division_primes()
+		{
+			static const std::vector<uint32_t> primes = small_primes(1024);
+			return primes;
+		}
+	}
+	
+	// Pollard's rho with Brent's cycle detection.  the differences |x - y|
+	//	are multiplied together and one gcd is taken per batch of
+	//	batch steps, backtracking if a batch overshoots.  returns a
+	//	nontrivial factor of the odd composite n, or n if max_cycle is
+	//	nonzero and the cycle search gets longer than that.
+	inline unsigned long long pollard_brent(unsigned long long n, unsigned batch = 128,
+											unsigned long long max_cycle = 0)
+	{
+		if (even(n)) return 2;
+		
+		detail::modular_arithmetic64 mod(n);
+		for (unsigned long long c0 = 1; ; ++c0)
+		{
+			const unsigned long long c = mod.to(c0);
+			unsigned long long y = mod.to(c0 + 1), x = y, ys = y;
+			unsigned long long q = mod.to(1);
+			unsigned long long g = 1;
+			
+			for (unsigned long long r = 1; g == 1; r <<= 1)
+			{
+				if (max_cycle && r > max_cycle) return n;
+				x = y;
+				for (unsigned long long i = 0; i < r; ++i) y = mod.add(mod.multiply(y, y), c);
+				for (unsigned long long k = 0; k < r && g == 1; k += batch)
+				{
+					ys = y;
+					unsigned long long steps = std::min<unsigned long long>(batch, r - k);
+					for (unsigned long long i = 0; i < steps; ++i)
+					{
+						y = mod.add(mod.multiply(y, y), c);
+						q = mod.multiply(q, x > y ? x - y : y - x);
+					}
+					g = gcd(q, n);
+				}
+			}
+			if (g == n)
+			{	// the batch went past the factor; walk it one step at a time
+				do
+				{
+					ys = mod.add(mod.multiply(ys, ys), c);
+					g = gcd(x > ys ? x - ys : ys - x, n);
+				} while (g == 1);
+			}
+			if (g != n) return g;
+			// x and y met modulo every factor at once.  try another polynomial.
+		}
+	}
+	
+	namespace detail
+	{
+		// rho finds a factor p after about sqrt(p) steps, so a cycle this
+		//	long means the factors are unusually hard for it; hand over to ECM.
+		const unsigned long long rho_cycle_limit = 1ULL << 22;
+		
+		// factor a number with no prime factors below the trial division
+		//	bound: Miller-Rabin, then split with rho (or ECM) and recurse.
+		inline void factor_rho(unsigned long long n, std::vector<unsigned long long>& factors)
+		{
+			if (n == 1) return;
+			if (miller_rabin(n))
+			{
+				factors.push_back(n);
+				return;
+			}
+			unsigned long long d = pollard_brent(n, 128, rho_cycle_limit);
+			if (d == n) d = ecm_factor(n);
+			if (d == n) d = pollard_brent(n);
+			factor_rho(d, factors);
+			factor_rho(n / d, factors);
+		}
+		
+		// trial division by the small prime table, then rho
+		inline std::vector<unsigned long long> factor64(unsigned long long n)
+		{
+			std::vector<unsigned long long> factors;
+			const std::vector<uint32_t>& primes = trial_division_primes();
+			for (size_t i = 0; i < primes.size(); ++i)
+			{
+				unsigned long long p = primes[i];
+				if (p * p > n) break;
+				while (n % p == 0)
+				{
+					factors.push_back(p);
+					n /= p;
+				}
+			}
+			if (n > 1)
+			{
+				unsigned long long bound = primes.back();
+				if (n <= bound * bound)
+					factors.push_back(n);	// no factor below sqrt(n) left
+				else
+					factor_rho(n, factors);
+			}
+			std::sort(factors.begin(), factors.end());
+			return factors;
+		}
+		
+		template<typename T, typename Container>
+		void factor_positive(T t, std::back_insert_iterator<Container> out, native_integer_tag<true>)
+		{
+			std::vector<unsigned long long> factors = factor64((unsigned long long)t);
+			for (size_t i = 0; i < factors.size(); ++i)
+			{
+				out++ = T(factors[i]);
+			}
+		}
+		
+		// strong probable prime test to the bases 2, 3, ..., 37.  exact
+		//	below 3.3*10^24 and very unlikely to be wrong above that.
+		template<typename T>
+		bool probable_prime(const T& n)
+		{
+			const std::vector<uint32_t>& primes = trial_division_primes();
+			for (size_t i = 0; i < 12; ++i)
+			{
+				if (n % T(primes[i]) == T(0)) return n == T(primes[i]);
+			}
+			
+			T d = n - T(1);
+			int s = 0;
+			while (even(d)) { d /= T(2); ++s; }
+			
+			const T n1 = n - T(1);
+			modular_mult<T> op(n);
+			for (size_t i = 0; i < 12; ++i)
+			{
+				T x = power(T(primes[i]), d, op);
+				if (x == T(1) || x == n1) continue;
+				int r = 1;
+				for (; r < s; ++r)
+				{
+					x = op(x, x);
+					if (x == n1) break;
+				}
+				if (r == s) return false;
+			}
 			return true;
-		return false;
+		}
+		
+		// split an odd n with no small factors using ECM and recurse.  the
+		//	bounds grow from those suited to 10 digit factors to those for
+		//	30 digits, so small factors are found cheaply.  a number that
+		//	every curve misses is out of reach (a scan down from its square
+		//	root would never finish), so it is an error.
+		template<typename T, typename Container>
+		void factor_ecm(const T& n, Container& factors)
+		{
+			if (probable_prime(n))
+			{
+				factors.push_back(n);
+				return;
+			}
+			static const uint64_t B1[] = { 2000, 11000, 50000, 250000 };
+			static const unsigned curves[] = { 25, 90, 300, 700 };
+			T d = n;
+			for (size_t i = 0; i < 4 && (d == n || d == T(1)); ++i)
+			{
+				d = ecm_factor(n, ecm_parameters(B1[i], 0, curves[i]));
+			}
+			if (d == n || d == T(1))
+			{
+				throw std::runtime_error("num::prime_factors - no factor found within the ECM bounds.");
+			}
+			factor_ecm(d, factors);
+			factor_ecm(T(n / d), factors);
+		}
+		
+		template<typename T, typename Container>
+		void factor_positive(T t, std::back_insert_iterator<Container> out, native_integer_tag<false>)
+		{
+			std::vector<T> factors;
+			const std::vector<uint32_t>& primes = trial_division_primes();
+			for (size_t i = 0; i < primes.size(); ++i)
+			{
+				const T p(primes[i]);
+				if (p * p > t) break;
+				while (t % p == T(0))
+				{
+					factors.push_back(p);
+					t /= p;
+				}
+			}
+			if (t != T(1))
+			{
+				const T bound(primes.back());
+				if (t <= bound * bound)
+					factors.push_back(t);
+				else
+					factor_ecm(t, factors);
+			}
+			std::sort(factors.begin(), factors.end());
+			for (size_t i = 0; i < factors.size(); ++i)
+			{
+				out++ = factors[i];
+			}
+		}
 	}
-
-	// prime factors
+	
+	// prime factors.  throws if t is wider than 64 bits and has two
+	//	factors too large for ECM (past about 30 digits each).
 	template<typename T, typename Container>
 	// requires Integer(T)
 	void prime_factors(T t, std::back_insert_iterator<Container> out)
 	{
-		if (t <= T(0))
+		if (t == T(0))
+		{
+			throw std::runtime_error("num::prime_factors - zero has no prime factorization.");
+		}
+		if (t < T(0))
 		{
 			out++ = T(-1);
 			t /= T(-1);
@@ -67,15 +403,8 @@ namespace num
 			out++ = T(1);
 			return;
 		}
-		while (even(t)) 
-		{ 
-			out++ = T(2);
-			t /= T(2);
-		}
-		if (t != T(1))
-		{
-			get_divisors(t, out);
-		}
+		detail::factor_positive(t, out, detail::native_integer_tag<std::numeric_limits<T>::is_integer
+								&& std::numeric_limits<T>::digits <= 64>());
 	}
 	
 };
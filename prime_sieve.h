@@ -0,0 +1,426 @@
+/*
+ *  prime_sieve.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * Segmented sieve of Eratosthenes.  Only numbers prime to 2, 3 and 5
+ *	are stored: one byte covers 30 integers with a bit for each of the
+ *	residues 1, 7, 11, 13, 17, 19, 23, 29.  Segments are sized to the L1
+ *	cache and each thread sieves its own contiguous run of segments.
+ *	Primes are streamed a segment at a time, so ranges far larger than
+ *	memory can be walked.
+ */
+
+#ifndef PRIME_SIEVE_H
+#define PRIME_SIEVE_H
+
+#include <vector>
+#include <iterator>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdint.h>
+
+#include "parallel.h"
+
+namespace num
+{
+	namespace detail
+	{
+		static const unsigned char wheel30_residue[8] = { 1, 7, 11, 13, 17, 19, 23, 29 };
+		// distance from each residue to the next one
+		static const unsigned char wheel30_gap[8] = { 6, 4, 2, 4, 2, 4, 6, 2 };
+		// bit index of a residue mod 30, 8 if it shares a factor with 30
+		static const unsigned char wheel30_bit[30] = {
+			8, 0, 8, 8, 8, 8, 8, 1, 8, 8, 8, 2, 8, 3, 8, 8, 8, 4, 8, 5, 8, 8, 8, 6, 8, 8, 8, 8, 8, 7 };
+
+		// for a prime p = 30a + r_b and a cofactor q = r_w (mod 30):
+		//	mask[b][w] clears the bit of p*q, and the byte of the next
+		//	multiple p*(q + gap[w]) is a*gap[w] + carry[b][w] further on.
+		//	a full cycle of eight steps moves exactly p bytes.
+		struct wheel30_step_tables
+		{
+			unsigned char mask[8][8];
+			unsigned char carry[8][8];
+			unsigned char offset[8][8];	// carries summed over the first w steps
+
+			wheel30_step_tables()
+			{
+				for (int b = 0; b < 8; ++b)
+				{
+					for (int w = 0; w < 8; ++w)
+					{
+						unsigned r = (unsigned)wheel30_residue[b] * wheel30_residue[w];
+						mask[b][w] = (unsigned char)~(1u << wheel30_bit[r % 30]);
+						carry[b][w] = (unsigned char)((r % 30 + wheel30_residue[b] * wheel30_gap[w]) / 30);
+						offset[b][w] = (unsigned char)(w == 0 ? 0 : offset[b][w-1] + carry[b][w-1]);
+					}
+				}
+			}
+		};
+		static const wheel30_step_tables wheel30_tables;
+
+		inline uint64_t floor_square_root(uint64_t n)
+		{
+			uint64_t r = (uint64_t)std::sqrt((double)n);
+			while (r > 0 && r * r > n) --r;
+			while ((r + 1) * (r + 1) <= n) ++r;
+			return r;
+		}
+
+		// all primes <= n with a plain sieve.  n is small (a square root).
+		inline std::vector<uint32_t> small_primes(uint64_t n)
+		{
+			std::vector<uint32_t> primes;
+			std::vector<bool> composite(n + 1, false);
+			for (uint64_t i = 2; i <= n; ++i)
+			{
+				if (composite[i]) continue;
+				primes.push_back((uint32_t)i);
+				for (uint64_t j = i * i; j <= n; j += i) composite[j] = true;
+			}
+			return primes;
+		}
+	}
+
+	class prime_sieve
+	{
+	public:
+		// sieve for primes up to and including limit.  segment_bytes is
+		//	the working set of one sieving thread (30 numbers per byte).
+		explicit prime_sieve(uint64_t limit, size_t segment_bytes = 32 * 1024)
+		: _limit(limit), _segment_bytes(segment_bytes > 0 ? segment_bytes : 1)
+		{
+			std::vector<uint32_t> all = detail::small_primes(detail::floor_square_root(limit));
+			for (size_t i = 0; i < all.size(); ++i)
+			{
+				if (all[i] >= 7) _primes.push_back(all[i]);
+			}
+		}
+
+		uint64_t limit() const { return _limit; }
+		size_t segment_bytes() const { return _segment_bytes; }
+
+		// walks the segments of a byte range in order, keeping the next
+		//	multiple of every sieving prime between segments so no prime
+		//	needs a division per segment.
+		class cursor
+		{
+		public:
+			cursor() : _sieve(0), _next_byte(0), _end_byte(0) {}
+
+			cursor(const prime_sieve& sieve, uint64_t first_byte, uint64_t end_byte)
+			: _sieve(&sieve), _next_byte(first_byte), _end_byte(end_byte)
+			, _multiple(sieve._primes.size(), 0), _wheel(sieve._primes.size(), 0)
+			{}
+
+			// sieve the next segment into bits.  returns false when done.
+			bool next(std::vector<uint8_t>& bits, uint64_t& first_byte)
+			{
+				if (_next_byte >= _end_byte) return false;
+				first_byte = _next_byte;
+				size_t n = (size_t)std::min<uint64_t>(_sieve->_segment_bytes, _end_byte - _next_byte);
+				_next_byte += n;
+				bits.assign(n, 0xFF);
+				sieve(first_byte, bits);
+				return true;
+			}
+
+		private:
+			void sieve(uint64_t first_byte, std::vector<uint8_t>& bits)
+			{
+				const std::vector<uint32_t>& primes = _sieve->_primes;
+				const uint64_t end_byte = first_byte + bits.size();
+				const uint64_t high = end_byte * 30;	// exclusive
+				if (first_byte == 0) bits[0] &= 0xFE;	// 1 is not prime
+
+				for (size_t i = 0; i < primes.size(); ++i)
+				{
+					const uint64_t p = primes[i];
+					if (p * p >= high) break;
+
+					// p = 30a + b.  multiples p*q walk q through the wheel; the
+					//	bit and the byte step only depend on b and q mod 30.
+					const uint64_t a = p / 30;
+					const unsigned b = detail::wheel30_bit[p % 30];
+					uint64_t byte = _multiple[i];
+					unsigned w = _wheel[i];
+					if (byte == 0)
+					{	// first use: the first multiple p*q >= max(p*p, low) with q prime to 30
+						uint64_t q = std::max<uint64_t>(p, (first_byte * 30 + p - 1) / p);
+						while (detail::wheel30_bit[q % 30] == 8) ++q;
+						byte = p * q / 30;
+						w = detail::wheel30_bit[q % 30];
+					}
+					// single steps up to the start of a wheel cycle
+					for (; w != 0 && byte < end_byte; w = (w + 1) & 7)
+					{
+						bits[byte - first_byte] &= detail::wheel30_tables.mask[b][w];
+						byte += a * detail::wheel30_gap[w] + detail::wheel30_tables.carry[b][w];
+					}
+					if (w == 0 && byte < end_byte)
+					{	// whole cycles: eight independent stores, then p bytes on
+						const unsigned char* mask = detail::wheel30_tables.mask[b];
+						const unsigned char* offset = detail::wheel30_tables.offset[b];
+						const uint64_t o1 = a * 6 + offset[1], o2 = a * 10 + offset[2], o3 = a * 12 + offset[3];
+						const uint64_t o4 = a * 16 + offset[4], o5 = a * 18 + offset[5], o6 = a * 22 + offset[6];
+						const uint64_t o7 = a * 28 + offset[7];
+						uint8_t* s = &bits[0];
+						uint64_t k = byte - first_byte;
+						for (const uint64_t n = bits.size(); k + o7 < n; k += p)
+						{
+							s[k] &= mask[0]; s[k + o1] &= mask[1]; s[k + o2] &= mask[2]; s[k + o3] &= mask[3];
+							s[k + o4] &= mask[4]; s[k + o5] &= mask[5]; s[k + o6] &= mask[6]; s[k + o7] &= mask[7];
+						}
+						byte = k + first_byte;
+					}
+					for (; byte < end_byte; w = (w + 1) & 7)
+					{
+						bits[byte - first_byte] &= detail::wheel30_tables.mask[b][w];
+						byte += a * detail::wheel30_gap[w] + detail::wheel30_tables.carry[b][w];
+					}
+					_multiple[i] = byte;
+					_wheel[i] = (unsigned char)w;
+				}
+			}
+
+			const prime_sieve* _sieve;
+			uint64_t _next_byte;
+			uint64_t _end_byte;
+			std::vector<uint64_t> _multiple;
+			std::vector<unsigned char> _wheel;
+		};
+
+		// call f(p) for every prime lo <= p <= hi, in increasing order
+		template<typename F>
+		void for_each_prime(uint64_t lo, uint64_t hi, F f) const
+		{
+			check_range(hi);
+			static const uint64_t wheel_primes[3] = { 2, 3, 5 };
+			for (int i = 0; i < 3; ++i)
+			{
+				if (wheel_primes[i] >= lo && wheel_primes[i] <= hi) f(wheel_primes[i]);
+			}
+			if (hi < 7 || lo > hi) return;
+
+			cursor c(*this, lo / 30, hi / 30 + 1);
+			std::vector<uint8_t> bits;
+			uint64_t first_byte;
+			while (c.next(bits, first_byte))
+			{
+				for (size_t b = 0; b < bits.size(); ++b)
+				{
+					for (unsigned set = bits[b]; set != 0; set &= set - 1)
+					{
+						uint64_t p = (first_byte + b) * 30 + detail::wheel30_residue[__builtin_ctz(set)];
+						if (p > hi) return;
+						if (p >= lo) f(p);
+					}
+				}
+			}
+		}
+
+		// append every prime lo <= p <= hi (a prime table)
+		template<typename Container>
+		void primes(uint64_t lo, uint64_t hi, std::back_insert_iterator<Container> out) const
+		{
+			for_each_prime(lo, hi, appender<Container>(out));
+		}
+
+		// call f(p, thread_index) for every prime lo <= p <= hi.  each
+		//	thread sieves its own contiguous range of segments and calls f
+		//	with increasing primes; calls from different threads interleave.
+		template<typename F>
+		void parallel_for_each_prime(uint64_t lo, uint64_t hi, F f, unsigned threads = 0) const
+		{
+			check_range(hi);
+			if (lo > hi) return;
+			parallel_for_chunks<uint64_t>(lo / 30, hi / 30 + 1, threads,
+				[this, lo, hi, &f](uint64_t first, uint64_t end, unsigned t)
+				{
+					uint64_t from = std::max<uint64_t>(lo, first * 30);
+					uint64_t to = std::min<uint64_t>(hi, end * 30 - 1);
+					for_each_prime(from, to, [&f, t](uint64_t p) { f(p, t); });
+				}, (uint64_t)_segment_bytes);
+		}
+
+		// number of primes lo <= p <= hi
+		uint64_t count(uint64_t lo, uint64_t hi, unsigned threads = 0) const
+		{
+			check_range(hi);
+			if (lo > hi) return 0;
+			if (threads == 0) threads = hardware_threads();
+
+			uint64_t total = 0;
+			static const uint64_t wheel_primes[3] = { 2, 3, 5 };
+			for (int i = 0; i < 3; ++i)
+			{
+				if (wheel_primes[i] >= lo && wheel_primes[i] <= hi) ++total;
+			}
+			if (hi < 7) return total;
+
+			const uint64_t first_byte = lo / 30, last_byte = hi / 30;
+			std::vector<uint64_t> counts(threads, 0);
+			parallel_for_chunks<uint64_t>(first_byte, last_byte + 1, threads,
+				[&](uint64_t first, uint64_t end, unsigned t)
+				{
+					cursor c(*this, first, end);
+					std::vector<uint8_t> bits;
+					uint64_t segment;
+					uint64_t n = 0;
+					while (c.next(bits, segment))
+					{
+						for (size_t b = 0; b < bits.size(); ++b)
+						{
+							uint64_t byte = segment + b;
+							if (byte == first_byte || byte == last_byte)
+							{	// the ends of the range need their bits checked
+								for (unsigned set = bits[b]; set != 0; set &= set - 1)
+								{
+									uint64_t p = byte * 30 + detail::wheel30_residue[__builtin_ctz(set)];
+									if (p >= lo && p <= hi) ++n;
+								}
+							}
+							else n += __builtin_popcount(bits[b]);
+						}
+					}
+					counts[t] = n;
+				}, (uint64_t)_segment_bytes);
+
+			for (size_t t = 0; t < counts.size(); ++t) total += counts[t];
+			return total;
+		}
+
+		uint64_t count(uint64_t hi) const { return count(0, hi); }
+
+		// streams the primes lo <= p <= hi one segment at a time
+		class iterator
+		{
+		public:
+			typedef std::input_iterator_tag iterator_category;
+			typedef uint64_t value_type;
+			typedef ptrdiff_t difference_type;
+			typedef const uint64_t* pointer;
+			typedef const uint64_t& reference;
+
+			iterator() : _value(0), _lo(0), _hi(0), _first_byte(0), _byte(0), _set(0), _small(3), _at_end(true) {}
+
+			iterator(const prime_sieve& sieve, uint64_t lo, uint64_t hi)
+			: _value(0), _lo(lo), _hi(hi), _first_byte(0), _byte(0), _set(0), _small(0), _at_end(false)
+			{
+				sieve.check_range(hi);
+				if (hi >= 7 && lo <= hi) _cursor = cursor(sieve, lo / 30, hi / 30 + 1);
+				++*this;
+			}
+
+			reference operator*() const { return _value; }
+			pointer operator->() const { return &_value; }
+
+			iterator& operator++()
+			{
+				static const uint64_t wheel_primes[3] = { 2, 3, 5 };
+				while (_small < 3)
+				{
+					uint64_t p = wheel_primes[_small++];
+					if (p >= _lo && p <= _hi)
+					{
+						_value = p;
+						return *this;
+					}
+				}
+				while (true)
+				{
+					while (_set == 0)
+					{
+						if (++_byte >= _bits.size())
+						{
+							if (!_cursor.next(_bits, _first_byte))
+							{
+								_at_end = true;
+								return *this;
+							}
+							_byte = 0;
+						}
+						_set = _bits[_byte];
+					}
+					uint64_t p = (_first_byte + _byte) * 30 + detail::wheel30_residue[__builtin_ctz(_set)];
+					_set &= _set - 1;
+					if (p > _hi) break;
+					if (p >= _lo)
+					{
+						_value = p;
+						return *this;
+					}
+				}
+				_cursor = cursor();
+				_at_end = true;
+				return *this;
+			}
+
+			iterator operator++(int)
+			{
+				iterator i(*this);
+				++*this;
+				return i;
+			}
+
+			friend bool operator==(const iterator& left, const iterator& right)
+			{
+				if (left._at_end || right._at_end) return left._at_end == right._at_end;
+				return left._value == right._value;
+			}
+
+			friend bool operator!=(const iterator& left, const iterator& right)
+			{ return !(left == right); }
+
+		private:
+			cursor _cursor;
+			std::vector<uint8_t> _bits;
+			uint64_t _value;
+			uint64_t _lo;
+			uint64_t _hi;
+			uint64_t _first_byte;
+			size_t _byte;
+			unsigned _set;
+			int _small;
+			bool _at_end;
+		};
+
+		iterator begin(uint64_t lo = 0) const { return iterator(*this, lo, _limit); }
+		iterator begin(uint64_t lo, uint64_t hi) const { return iterator(*this, lo, hi); }
+		iterator end() const { return iterator(); }
+
+	private:
+		template<typename Container>
+		struct appender
+		{
+			std::back_insert_iterator<Container> out;
+			appender(std::back_insert_iterator<Container> o) : out(o) {}
+			void operator()(uint64_t p) { out++ = typename Container::value_type(p); }
+		};
+
+		void check_range(uint64_t hi) const
+		{
+			if (hi > _limit)
+			{
+				throw std::runtime_error("num::prime_sieve - range exceeds the sieve limit.");
+			}
+		}
+
+		uint64_t _limit;
+		size_t _segment_bytes;
+		std::vector<uint32_t> _primes;	// sieving primes 7 <= p <= sqrt(limit)
+	};
+
+	// all primes <= n
+	template<typename Container>
+	void primes_up_to(uint64_t n, std::back_insert_iterator<Container> out)
+	{
+		prime_sieve(n).primes(0, n, out);
+	}
+};
+
+#endif // PRIME_SIEVE_H
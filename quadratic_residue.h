@@ -0,0 +1,296 @@
+/*
+ *  quadratic_residue.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * Quadratic residues modulo an odd prime p.  The Jacobi symbol is
+ *	computed with the binary algorithm (shifts and subtractions, no
+ *	division) for native integers.  Square roots use the closed forms
+ *	when p = 3 (mod 4) or 5 (mod 8), Tonelli-Shanks when p - 1 has few
+ *	factors of two and Cipolla's method when it has many, since the cost
+ *	of Tonelli-Shanks grows with the square of that count.
+ */
+
+#ifndef QUADRATIC_RESIDUE_H
+#define QUADRATIC_RESIDUE_H
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "integer.h"
+#include "gcd.h"
+#include "finite_integral_type.h"
+
+namespace num
+{
+	namespace detail
+	{
+		// (a/n) for odd n, with 0 <= a.  strip the twos of a in one shift,
+		//	then subtract the smaller odd number from the larger, flipping
+		//	the sign by the reciprocity rules as needed.
+		inline int jacobi_binary(unsigned long long a, unsigned long long n)
+		{
+			int t = 1;
+			a %= n;
+			while (a != 0)
+			{
+				const int z = count_trailing_zeros(a);
+				a >>= z;
+				if ((z & 1) && ((n & 7) == 3 || (n & 7) == 5)) t = -t;
+				if (a < n)
+				{
+					unsigned long long swap = a; a = n; n = swap;
+					if ((a & 3) == 3 && (n & 3) == 3) t = -t;
+				}
+				a -= n;
+			}
+			return n == 1 ? t : 0;
+		}
+
+		template<typename T>
+		int jacobi(const T& a, const T& n, binary_gcd_tag)
+		{
+			unsigned long long r = (unsigned long long)(a % n < T(0) ? a % n + n : a % n);
+			return jacobi_binary(r, (unsigned long long)n);
+		}
+
+		template<typename T, typename Tag>
+		int jacobi(T a, T n, Tag)
+		{	// the same rules with a remainder in place of the subtraction
+			a %= n;
+			if (a < T(0)) a += n;
+			int t = 1;
+			while (a != T(0))
+			{
+				while (even(a))
+				{
+					a /= T(2);
+					T r = n % T(8);
+					if (r == T(3) || r == T(5)) t = -t;
+				}
+				T swap = a; a = n; n = swap;
+				if (a % T(4) == T(3) && n % T(4) == T(3)) t = -t;
+				a %= n;
+			}
+			return n == T(1) ? t : 0;
+		}
+
+		template<typename T>
+		T subtract_mod(const T& a, const T& b, const T& m)
+		{
+			return a >= b ? a - b : a + (m - b);
+		}
+
+		// the smaller of the two roots r and p - r
+		template<typename T>
+		T smaller_root(const T& r, const T& p)
+		{
+			return r > p - r ? p - r : r;
+		}
+
+		// a residue reduced into [0, p)
+		template<typename T>
+		T reduce(const T& a, const T& p)
+		{
+			T r = a % p;
+			return r < T(0) ? r + p : r;
+		}
+
+		template<typename T>
+		void check_residue(const T& a, const T& p, const char* who)
+		{
+			if (p < T(3) || even(p))
+			{
+				throw std::runtime_error(std::string("num::") + who + " - the modulus must be an odd prime.");
+			}
+			if (jacobi(a, p, typename gcd_category<T>::type()) < 0)
+			{
+				throw std::runtime_error(std::string("num::") + who + " - not a quadratic residue.");
+			}
+		}
+
+		// x + y w in F_p[w] / (w^2 - d), as a binary operation for power()
+		template<typename T>
+		struct quadratic_extension
+		{
+			T x, y;
+			quadratic_extension(const T& a = T(1), const T& b = T(0)) : x(a), y(b) {}
+		};
+
+		template<typename T>
+		class quadratic_extension_mult
+		{
+		public:
+			typedef size_t DistanceType;
+			typedef quadratic_extension<T> domain;
+
+			quadratic_extension_mult(const T& d, const T& p) : _d(d), _p(p) {}
+
+			domain operator()(const domain& a, const domain& b)
+			{
+				T yy = multiply_mod(multiply_mod(a.y, b.y, _p), _d, _p);
+				T x = multiply_mod(a.x, b.x, _p);
+				x = x >= _p - yy ? x - (_p - yy) : x + yy;
+				T xy = multiply_mod(a.x, b.y, _p), yx = multiply_mod(a.y, b.x, _p);
+				return domain(x, xy >= _p - yx ? xy - (_p - yx) : xy + yx);
+			}
+		private:
+			T _d, _p;
+		};
+
+		template<typename T>
+		unsigned two_adic_valuation(T q)
+		{
+			unsigned s = 0;
+			while (even(q)) { q = half_nonnegative(q); ++s; }
+			return s;
+		}
+	}
+
+	// the Jacobi symbol (a/n) for odd n > 0; the Legendre symbol when n
+	//	is prime.  1, -1, or 0 when a and n share a factor.
+	template<typename T>
+	// requires Integer(T)
+	int jacobi(const T& a, const T& n)
+	{
+		if (n <= T(0) || even(n))
+		{
+			throw std::runtime_error("num::jacobi - n must be odd and positive.");
+		}
+		return detail::jacobi(a, n, typename detail::gcd_category<T>::type());
+	}
+
+	template<typename T>
+	// requires Integer(T) && Prime(p)
+	int legendre(const T& a, const T& p)
+	{
+		return jacobi(a, p);
+	}
+
+	// square root of a modulo the odd prime p by Tonelli-Shanks.  with
+	//	p - 1 = q 2^s, the root of a^q is found in the 2^s-element subgroup
+	//	one bit of the exponent at a time.  returns the smaller root and
+	//	throws if a is not a square.
+	template<typename T>
+	// requires Integer(T) && Prime(p)
+	T tonelli_shanks(const T& a, const T& p)
+	{
+		detail::check_residue(a, p, "tonelli_shanks");
+		const T n = detail::reduce(a, p);
+		if (n == T(0)) return T(0);
+
+		modular_mult<T> op(p);
+		T q = p - T(1);
+		unsigned s = detail::two_adic_valuation(q);
+		for (unsigned i = 0; i < s; ++i) q = half_nonnegative(q);
+
+		T z(2);
+		while (jacobi(z, p) != -1) ++z;
+
+		unsigned m = s;
+		T c = power(z, q, op);
+		T t = power(n, q, op);
+		T r = power(n, half_nonnegative(q + T(1)), op);
+		while (t != T(1))
+		{
+			unsigned i = 0;
+			for (T u = t; u != T(1); u = op(u, u)) ++i;
+			T b = c;
+			for (unsigned j = 0; j + i + 1 < m; ++j) b = op(b, b);
+			m = i;
+			c = op(b, b);
+			t = op(t, c);
+			r = op(r, b);
+		}
+		return detail::smaller_root(r, p);
+	}
+
+	// square root of a modulo the odd prime p by Cipolla's method: for
+	//	any t with t^2 - a a non-residue, (t + w)^((p+1)/2) = sqrt(a) in
+	//	F_p[w] with w^2 = t^2 - a.  O(log p) regardless of p - 1.
+	template<typename T>
+	// requires Integer(T) && Prime(p)
+	T cipolla(const T& a, const T& p)
+	{
+		detail::check_residue(a, p, "cipolla");
+		const T n = detail::reduce(a, p);
+		if (n == T(0)) return T(0);
+
+		T t(1), d;
+		for (;; ++t)
+		{
+			d = detail::subtract_mod(multiply_mod(t, t, p), n, p);
+			if (jacobi(d, p) == -1) break;
+		}
+		typedef detail::quadratic_extension<T> element;
+		element r = power(element(t, T(1)), half_nonnegative(p + T(1)), detail::quadratic_extension_mult<T>(d, p));
+		return detail::smaller_root(r.x, p);
+	}
+
+	// square root of a modulo the odd prime p by the cheapest method for
+	//	p.  returns the smaller root; throws if a is not a square.
+	template<typename T>
+	// requires Integer(T) && Prime(p)
+	T modular_square_root(const T& a, const T& p)
+	{
+		detail::check_residue(a, p, "modular_square_root");
+		const T n = detail::reduce(a, p);
+		if (n == T(0)) return T(0);
+
+		modular_mult<T> op(p);
+		if (p % T(4) == T(3))
+		{	// a^((p+1)/4)
+			return detail::smaller_root(power(n, (p + T(1)) / T(4), op), p);
+		}
+		if (p % T(8) == T(5))
+		{	// Atkin: v = (2a)^((p-5)/8), i = 2 a v^2, root = a v (i - 1)
+			T a2 = multiply_mod(T(2), n, p);
+			T v = power(a2, (p - T(5)) / T(8), op);
+			T i = op(a2, op(v, v));
+			return detail::smaller_root(op(op(n, v), detail::subtract_mod(i, T(1), p)), p);
+		}
+
+		// Tonelli-Shanks costs about log p + s^2/4 multiplications and
+		//	Cipolla about 3 log p.
+		unsigned s = detail::two_adic_valuation(p - T(1));
+		unsigned bits = 0;
+		for (T q = p; q != T(0); q = half_nonnegative(q)) ++bits;
+		return s * s > 12 * bits ? cipolla(n, p) : tonelli_shanks(n, p);
+	}
+
+	// the same over finite_integral_type, where BASE is an odd prime
+	template<typename FIT>
+	int legendre(const FIT& a)
+	{
+		return jacobi(detail::residue(a), FIT::base());
+	}
+
+	template<typename FIT>
+	bool is_quadratic_residue(const FIT& a)
+	{
+		return legendre(a) >= 0;
+	}
+
+	template<typename FIT>
+	FIT tonelli_shanks(const FIT& a)
+	{
+		return FIT(tonelli_shanks(detail::residue(a), FIT::base()));
+	}
+
+	template<typename FIT>
+	FIT cipolla(const FIT& a)
+	{
+		return FIT(cipolla(detail::residue(a), FIT::base()));
+	}
+
+	template<typename FIT>
+	FIT modular_square_root(const FIT& a)
+	{
+		return FIT(modular_square_root(detail::residue(a), FIT::base()));
+	}
+};
+
+#endif // QUADRATIC_RESIDUE_H
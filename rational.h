@@ -16,7 +16,58 @@
 
 namespace num
 {
-	template<class T>
+	// the normalization policy of a rational.  eager reduces with a gcd
+	//	after every operation; lazy cancels the cross terms (Henrici) and
+	//	only reduces in full when the numerator or denominator is read.
+	struct eager_normalization {};
+	struct lazy_normalization {};
+
+	namespace detail
+	{
+		// Henrici's forms for the sum and product of n1/d1 and n2/d2 with
+		//	positive denominators.  only the cross terms are cancelled, so
+		//	the gcds are of smaller numbers than the full numerator and
+		//	denominator, and reduced operands give a reduced result.  the
+		//	gcds are skipped when a denominator is 1 or they are equal.
+		template<typename U>
+		void henrici_sum(const U& n1, const U& d1, const U& n2, const U& d2, U& n, U& d)
+		{
+			if (d1 == U(1)) { n = n1 * d2 + n2; d = d2; return; }
+			if (d2 == U(1)) { n = n1 + n2 * d1; d = d1; return; }
+			if (d1 == d2)
+			{
+				U t = n1 + n2;
+				if (t == U(0)) { n = U(0); d = U(1); return; }
+				U g = num::gcd(t, d1);
+				n = t / g;
+				d = d1 / g;
+				return;
+			}
+			U g = num::gcd(d1, d2);
+			if (g == U(1))
+			{
+				n = n1 * d2 + n2 * d1;
+				d = d1 * d2;
+				return;
+			}
+			U t = n1 * (d2 / g) + n2 * (d1 / g);
+			if (t == U(0)) { n = U(0); d = U(1); return; }
+			U g2 = num::gcd(t, g);
+			n = t / g2;
+			d = (d1 / g) * (d2 / g2);
+		}
+
+		template<typename U>
+		void henrici_product(const U& n1, const U& d1, const U& n2, const U& d2, U& n, U& d)
+		{
+			if (n1 == U(0) || n2 == U(0)) { n = U(0); d = U(1); return; }
+			U g1 = d2 == U(1) ? U(1) : num::gcd(n1, d2), g2 = d1 == U(1) ? U(1) : num::gcd(n2, d1);
+			n = (n1 / g1) * (n2 / g2);
+			d = (d1 / g2) * (d2 / g1);
+		}
+	}
+
+	template<class T, class Normalization = eager_normalization>
 	class rational
 	{
 	public:
@@ -61,8 +112,8 @@ namespace num
 		}
 		
 		// accessors
-		const value_type& numerator() { return _num; }
-		const value_type& denominator() { return _denom; }
+		const value_type& numerator() const { return _num; }
+		const value_type& denominator() const { return _denom; }
 		
 		// overloads
 		const rational operator-() const
@@ -198,6 +249,189 @@ namespace num
 		}
 	};
 
+	// copies cost nothing, comparisons cross multiply, and the value is
+	//	reduced in full only when numerator() or denominator() is read.
+	//	sums and products of reduced values come out reduced, so a
+	//	reduction is only ever needed for values built from unreduced
+	//	pairs.  floor and ceil round toward -inf and +inf.
+	template<class T>
+	class rational<T, lazy_normalization>
+	{
+	public:
+		typedef T value_type;
+	private:
+		mutable value_type _num;
+		mutable value_type _denom;
+		mutable bool _reduced;
+
+		void normalize_negative()
+		{ // positive denom always
+			if (_denom < 0) { _num = -_num; _denom = -_denom; }
+		}
+		void reduce() const
+		{
+			if (_reduced) return;
+			value_type factor = num::gcd(_num, _denom);
+			if (factor != value_type(1)) { _num /= factor; _denom /= factor; }
+			_reduced = true;
+		}
+	public:
+		// ctor/dtor/assignment
+		rational(const value_type& num = 0, const value_type& denom = 1) : _num(num), _denom(denom), _reduced(false)
+		{
+			if (_denom == 0) throw std::runtime_error("rational ctor: zero denominator error.");
+			normalize_negative();
+			_reduced = (_denom == value_type(1));
+		}
+
+		// accessors
+		const value_type& numerator() const { reduce(); return _num; }
+		const value_type& denominator() const { reduce(); return _denom; }
+		bool reduced() const { return _reduced; }
+
+		// overloads
+		const rational operator-() const
+		{
+			rational r(*this);
+			r._num = -r._num;
+			return r;
+		}
+
+		rational& operator+=(const rational& r)
+		{
+			value_type n, d;
+			detail::henrici_sum(_num, _denom, r._num, r._denom, n, d);
+			_num = n; _denom = d;
+			_reduced = _reduced && r._reduced;
+			return *this;
+		}
+
+		rational& operator-=(const rational& r)
+		{
+			value_type n, d;
+			detail::henrici_sum(_num, _denom, value_type(-r._num), r._denom, n, d);
+			_num = n; _denom = d;
+			_reduced = _reduced && r._reduced;
+			return *this;
+		}
+
+		rational& operator*=(const rational& r)
+		{
+			value_type n, d;
+			detail::henrici_product(_num, _denom, r._num, r._denom, n, d);
+			_num = n; _denom = d;
+			_reduced = _reduced && r._reduced;
+			return *this;
+		}
+
+		rational& operator/=(const rational& r)
+		{
+			if (r._num == 0) throw std::runtime_error("rational operator/=(): zero denominator error.");
+			value_type n, d;
+			if (r._num < 0) detail::henrici_product(_num, _denom, value_type(-r._denom), value_type(-r._num), n, d);
+			else detail::henrici_product(_num, _denom, r._denom, r._num, n, d);
+			_num = n; _denom = d;
+			_reduced = _reduced && r._reduced;
+			return *this;
+		}
+
+		rational& operator%=(const rational& r)
+		{	// division is always complete in the rationals.  no remainder.
+			_num = T(0);
+			_denom = T(1);
+			_reduced = true;
+			return *this;
+		}
+
+		// helpers
+		rational& invert()
+		{
+			if (_num == 0) throw std::runtime_error("rational invert(): zero denominator error.");
+			value_type swap = _num;
+			_num = _denom;
+			_denom = swap;
+			normalize_negative();
+			return *this;
+		}
+
+		// friends
+		friend const rational operator+(rational l, const rational& r)
+		{
+			return l += r;
+		}
+
+		friend const rational operator-(rational l, const rational& r)
+		{
+			return l -= r;
+		}
+
+		friend const rational operator*(rational l, const rational& r)
+		{
+			return l *= r;
+		}
+
+		friend const rational operator/(rational l, const rational& r)
+		{
+			return l /= r;
+		}
+
+		friend const rational operator%(rational l, const rational& r)
+		{
+			return l %= r;
+		}
+
+		friend std::ostream& operator<<(std::ostream& os, const rational& r)
+		{
+			os << "(" << r.numerator() << ", " << r.denominator() << ")";
+			return os;
+		}
+
+		friend bool operator==(const rational& l, const rational& r)
+		{
+			if (l._reduced && r._reduced) return (l._num == r._num && l._denom == r._denom);
+			return l._num * r._denom == r._num * l._denom;
+		}
+
+		friend bool operator!=(const rational& l, const rational& r)
+		{
+			return !(l == r);
+		}
+
+		friend bool operator<(const rational& l, const rational& r)
+		{
+			return l._num * r._denom < r._num * l._denom;
+		}
+
+		friend bool operator>(const rational& l, const rational& r)
+		{
+			return r < l;
+		}
+
+		friend bool operator<=(const rational& l, const rational& r)
+		{
+			return !(r < l);
+		}
+
+		friend bool operator>=(const rational& l, const rational& r)
+		{
+			return !(l < r);
+		}
+
+		friend T floor(const rational& r)
+		{
+			T q = r._num / r._denom;
+			if (q * r._denom != r._num && r._num < 0) q -= T(1);
+			return q;
+		}
+
+		friend T ceil(const rational& r)
+		{
+			T q = r._num / r._denom;
+			if (q * r._denom != r._num && r._num > 0) q += T(1);
+			return q;
+		}
+	};
+
 }
 #endif //RATIONAL_H
 
@@ -0,0 +1,137 @@
+/*
+ *  rational_algorithms.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * Exact sums and products over a range of rationals.  Operands are
+ *	combined pairwise in a balanced tree, so both sides of every step
+ *	are about the same size.  Sums carry an unreduced numerator over the
+ *	lcm of the denominators below them and take a single gcd at the
+ *	root.  Products cancel the cross terms at each node, which keeps
+ *	every partial product reduced.  Leaf ranges and then each level of
+ *	the tree run as jobs on a thread pool.
+ */
+
+#ifndef RATIONAL_ALGORITHMS_H
+#define RATIONAL_ALGORITHMS_H
+
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <cstddef>
+
+#include "gcd.h"
+#include "rational.h"
+#include "parallel.h"
+
+namespace num
+{
+	namespace detail
+	{
+		// below this many operands a range stays on one thread
+		const size_t parallel_rational_grain = 256;
+
+		// below this many operands a sum or product runs without a pool
+		const size_t parallel_rational_work = 16 * parallel_rational_grain;
+
+		// a numerator and positive denominator, not necessarily reduced
+		template<typename T>
+		struct fraction
+		{
+			T num, denom;
+		};
+
+		// a/b + c/d = (a (d/g) + c (b/g)) / lcm(b, d) with g = gcd(b, d)
+		template<typename T>
+		fraction<T> common_denominator_sum(const fraction<T>& l, const fraction<T>& r)
+		{
+			fraction<T> s;
+			if (l.denom == r.denom)
+			{
+				s.num = l.num + r.num;
+				s.denom = l.denom;
+				return s;
+			}
+			T g = (l.denom == T(1) || r.denom == T(1)) ? T(1) : num::gcd(l.denom, r.denom);
+			if (g == T(1))
+			{
+				s.num = l.num * r.denom + r.num * l.denom;
+				s.denom = l.denom * r.denom;
+				return s;
+			}
+			T rd = r.denom / g;
+			s.num = l.num * rd + r.num * (l.denom / g);
+			s.denom = l.denom * rd;
+			return s;
+		}
+
+		template<typename T>
+		fraction<T> cancelled_product(const fraction<T>& l, const fraction<T>& r)
+		{
+			fraction<T> p;
+			henrici_product(l.num, l.denom, r.num, r.denom, p.num, p.denom);
+			return p;
+		}
+
+		template<typename T, typename Combine>
+		fraction<T> balanced_combine(const std::vector<fraction<T> >& f, size_t lo, size_t hi, Combine combine)
+		{
+			if (hi - lo == 1) return f[lo];
+			size_t mid = lo + (hi - lo) / 2;
+			return combine(balanced_combine(f, lo, mid, combine), balanced_combine(f, mid, hi, combine));
+		}
+
+		// f is not empty
+		template<typename T, typename Combine>
+		fraction<T> tree_combine(const std::vector<fraction<T> >& f, Combine combine, thread_pool* pool)
+		{
+			return parallel_tree_reduce<fraction<T> >(f.size(), [&f, combine](size_t lo, size_t hi) { return balanced_combine(f, lo, hi, combine); },
+													  combine, pool, parallel_rational_grain);
+		}
+
+		template<typename Iterator>
+		std::vector<fraction<typename std::iterator_traits<Iterator>::value_type::value_type> > fractions(Iterator first, Iterator last)
+		{
+			typedef typename std::iterator_traits<Iterator>::value_type::value_type T;
+			std::vector<fraction<T> > f;
+			for (; first != last; ++first)
+			{
+				fraction<T> x = { first->numerator(), first->denominator() };
+				f.push_back(x);
+			}
+			return f;
+		}
+	}
+
+	// the sum of a range of rationals; threads = 0 uses them all
+	template<typename Iterator>
+	// requires InputIterator(Iterator) && ValueType(Iterator) == rational<T, N>
+	typename std::iterator_traits<Iterator>::value_type rational_sum(Iterator first, Iterator last, unsigned threads = 0)
+	{
+		typedef typename std::iterator_traits<Iterator>::value_type R;
+		typedef typename R::value_type T;
+		std::vector<detail::fraction<T> > f = detail::fractions(first, last);
+		if (f.empty()) return R(T(0));
+		std::unique_ptr<thread_pool> pool;
+		detail::fraction<T> s = detail::tree_combine(f, detail::common_denominator_sum<T>, pool_for(pool, f.size(), detail::parallel_rational_work, threads));
+		return R(s.num, s.denom);
+	}
+
+	// the product of a range of rationals; threads = 0 uses them all
+	template<typename Iterator>
+	// requires InputIterator(Iterator) && ValueType(Iterator) == rational<T, N>
+	typename std::iterator_traits<Iterator>::value_type rational_product(Iterator first, Iterator last, unsigned threads = 0)
+	{
+		typedef typename std::iterator_traits<Iterator>::value_type R;
+		typedef typename R::value_type T;
+		std::vector<detail::fraction<T> > f = detail::fractions(first, last);
+		if (f.empty()) return R(T(1));
+		std::unique_ptr<thread_pool> pool;
+		detail::fraction<T> p = detail::tree_combine(f, detail::cancelled_product<T>, pool_for(pool, f.size(), detail::parallel_rational_work, threads));
+		return R(p.num, p.denom);
+	}
+};
+
+#endif // RATIONAL_ALGORITHMS_H
@@ -0,0 +1,279 @@
+/*
+ *  residue_number_system.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * A multi-modular integer: one residue per pairwise coprime modulus.
+ *	Addition, subtraction and multiplication act on each residue on its
+ *	own, with no carries between them, so a large computation can run
+ *	as independent per-modulus jobs and be combined at the end with
+ *	Garner's mixed radix form of the chinese remainder theorem.
+ */
+
+#ifndef RESIDUE_NUMBER_SYSTEM_H
+#define RESIDUE_NUMBER_SYSTEM_H
+
+#include <vector>
+#include <thread>
+#include <ostream>
+#include <cstddef>
+
+#include "integer.h"
+#include "gcd.h"
+#include "finite_integral_type.h"
+
+namespace num
+{
+	// the I'th value of a template parameter pack of moduli
+	template<size_t I, typename T, T M, T... REST>
+	struct nth_modulus
+	{
+		static const T value = nth_modulus<I-1, T, REST...>::value;
+	};
+
+	template<typename T, T M, T... REST>
+	struct nth_modulus<0, T, M, REST...>
+	{
+		static const T value = M;
+	};
+
+	template<typename T, T... MODULI>
+	// requires Integer(T) && PairwiseCoprime(MODULI)
+	class residue_number_system
+	{
+	public:
+		typedef T value_type;
+		typedef residue_number_system self_type;
+		static const size_t size = sizeof...(MODULI);
+
+	private:
+		value_type _r[sizeof...(MODULI)];
+
+		static const value_type* moduli()
+		{
+			static const value_type m[] = { MODULI... };
+			return m;
+		}
+
+		// inverse[i*size + j] = m_j^-1 mod m_i for j < i.  built once;
+		//	throws if two moduli share a factor.
+		static const std::vector<value_type>& garner_constants()
+		{
+			static const std::vector<value_type> c = make_garner_constants();
+			return c;
+		}
+
+		static std::vector<value_type> make_garner_constants()
+		{
+			const value_type* m = moduli();
+			std::vector<value_type> c(size * size, value_type(0));
+			for (size_t i = 0; i < size; ++i)
+			{
+				for (size_t j = 0; j < i; ++j)
+				{
+					c[i*size + j] = modular_inverse(m[j] % m[i], m[i]);
+				}
+			}
+			return c;
+		}
+
+		static value_type reduce(value_type v, const value_type& m)
+		{
+			v %= m;
+			return negative(v) ? v + m : v;
+		}
+
+	public:
+		residue_number_system()
+		{
+			for (size_t i = 0; i < size; ++i) _r[i] = value_type(0);
+		}
+
+		// any integer type with % by a value_type, e.g. long long or a
+		//	multiprecision integer.
+		template<typename W>
+		residue_number_system(const W& w)
+		{
+			const value_type* m = moduli();
+			for (size_t i = 0; i < size; ++i)
+			{
+				W r = w % W(m[i]);
+				if (r < W(0)) r += W(m[i]);
+				_r[i] = value_type(r);
+			}
+		}
+
+		// build from residues computed elsewhere (one per modulus)
+		static self_type from_residues(const value_type* residues)
+		{
+			self_type s;
+			for (size_t i = 0; i < size; ++i) s._r[i] = reduce(residues[i], moduli()[i]);
+			return s;
+		}
+
+		// run f(i, m_i) for each modulus on its own thread and collect the
+		//	results as the residues of a new value.  this is the per-prime
+		//	job pattern: f computes the answer modulo m_i.
+		template<typename F>
+		static self_type generate(F f, bool parallel = true)
+		{
+			value_type r[sizeof...(MODULI)];
+			const value_type* m = moduli();
+			if (!parallel || size == 1)
+			{
+				for (size_t i = 0; i < size; ++i) r[i] = f(i, m[i]);
+			}
+			else
+			{
+				std::vector<std::thread> threads;
+				for (size_t i = 0; i < size; ++i)
+				{
+					threads.push_back(std::thread([&r, &f, m, i]() { r[i] = f(i, m[i]); }));
+				}
+				for (size_t i = 0; i < threads.size(); ++i) threads[i].join();
+			}
+			return from_residues(r);
+		}
+
+		// accessors
+		static value_type modulus(size_t i) { return moduli()[i]; }
+		const value_type& residue(size_t i) const { return _r[i]; }
+
+		template<size_t I>
+		finite_integral_type<T, nth_modulus<I, T, MODULI...>::value> get() const
+		{
+			return finite_integral_type<T, nth_modulus<I, T, MODULI...>::value>(_r[I]);
+		}
+
+		// product of the moduli.  W must be wide enough to hold it.
+		template<typename W>
+		static W range()
+		{
+			W r(1);
+			for (size_t i = 0; i < size; ++i) r *= W(moduli()[i]);
+			return r;
+		}
+
+		// overloads.  each loop has independent lanes.
+		self_type& operator+=(const self_type& a)
+		{
+			const value_type* m = moduli();
+			for (size_t i = 0; i < size; ++i)
+			{
+				value_type s = _r[i] + a._r[i];
+				_r[i] = s >= m[i] ? s - m[i] : s;
+			}
+			return *this;
+		}
+
+		self_type& operator-=(const self_type& a)
+		{
+			const value_type* m = moduli();
+			for (size_t i = 0; i < size; ++i)
+			{
+				_r[i] = _r[i] >= a._r[i] ? _r[i] - a._r[i] : _r[i] + (m[i] - a._r[i]);
+			}
+			return *this;
+		}
+
+		self_type& operator*=(const self_type& a)
+		{
+			const value_type* m = moduli();
+			for (size_t i = 0; i < size; ++i)
+			{
+				_r[i] = multiply_mod(_r[i], a._r[i], m[i]);
+			}
+			return *this;
+		}
+
+		const self_type operator-() const
+		{
+			self_type s;
+			return s -= *this;
+		}
+
+		// Garner's algorithm: find the mixed radix digits v_i with
+		//	x = v_0 + v_1 m_0 + v_2 m_0 m_1 + ...   then evaluate in W.
+		//	the result is in [0, m_0 m_1 ... m_(k-1)).
+		template<typename W>
+		W to_integer() const
+		{
+			const value_type* m = moduli();
+			const std::vector<value_type>& c = garner_constants();
+
+			value_type v[sizeof...(MODULI)];
+			for (size_t i = 0; i < size; ++i)
+			{
+				value_type t = _r[i];
+				for (size_t j = 0; j < i; ++j)
+				{
+					value_type d = t >= v[j] % m[i] ? t - v[j] % m[i] : t + (m[i] - v[j] % m[i]);
+					t = multiply_mod(d, c[i*size + j], m[i]);
+				}
+				v[i] = t;
+			}
+
+			W x(v[size - 1]);
+			for (size_t i = size - 1; i > 0; --i)
+			{
+				x = x * W(m[i - 1]) + W(v[i - 1]);
+			}
+			return x;
+		}
+
+		// as to_integer, but in the symmetric range (-M/2, M/2]
+		template<typename W>
+		W to_signed_integer() const
+		{
+			W x = to_integer<W>();
+			W r = range<W>();
+			return (x > r / W(2)) ? x - r : x;
+		}
+
+		// friends
+		friend const self_type operator+(self_type left, const self_type& right)
+		{
+			return left += right;
+		}
+
+		friend const self_type operator-(self_type left, const self_type& right)
+		{
+			return left -= right;
+		}
+
+		friend const self_type operator*(self_type left, const self_type& right)
+		{
+			return left *= right;
+		}
+
+		friend bool operator==(const self_type& left, const self_type& right)
+		{
+			for (size_t i = 0; i < size; ++i)
+			{
+				if (left._r[i] != right._r[i]) return false;
+			}
+			return true;
+		}
+
+		friend bool operator!=(const self_type& left, const self_type& right)
+		{ return !(left == right); }
+
+		friend std::ostream& operator<<(std::ostream& out, const self_type& r)
+		{
+			out << "(";
+			for (size_t i = 0; i < size; ++i)
+			{
+				out << (i ? ", " : "") << r._r[i] << "(mod " << moduli()[i] << ")";
+			}
+			out << ")";
+			return out;
+		}
+	};
+
+	template<typename T, T... MODULI>
+	const size_t residue_number_system<T, MODULI...>::size;
+};
+
+#endif // RESIDUE_NUMBER_SYSTEM_H
@@ -0,0 +1,214 @@
+/*
+ *  smallest_prime_factor.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * A table of the smallest prime factor of every integer up to a limit,
+ *	built with the linear sieve (each composite is written exactly once).
+ *	With the table, factoring n is a walk of at most log2(n) lookups.
+ *	Only odd numbers are stored (the smallest factor of an even number
+ *	is 2), as 32 bit values, and the table can live in a memory mapped
+ *	file so it is built once and shared between runs and processes.
+ */
+
+#ifndef SMALLEST_PRIME_FACTOR_H
+#define SMALLEST_PRIME_FACTOR_H
+
+#include <vector>
+#include <string>
+#include <iterator>
+#include <stdexcept>
+#include <cstddef>
+#include <stdint.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "parallel.h"
+
+namespace num
+{
+	class smallest_prime_factor_table
+	{
+	public:
+		// build the table in memory for 1 <= n <= limit
+		explicit smallest_prime_factor_table(uint32_t limit)
+		: _limit(limit), _data(0), _mapping(0), _mapped_bytes(0)
+		{
+			_storage.assign(slots(limit), 0);
+			_data = _storage.empty() ? 0 : &_storage[0];
+			sieve();
+		}
+
+		// use the table stored in path, building and saving it first if
+		//	the file is missing or was built for a different limit.
+		smallest_prime_factor_table(uint32_t limit, const std::string& path)
+		: _limit(limit), _data(0), _mapping(0), _mapped_bytes(0)
+		{
+			const size_t bytes = sizeof(header) + slots(limit) * sizeof(uint32_t);
+
+			bool fresh = true;
+			int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+			if (fd < 0)
+			{
+				throw std::runtime_error("num::smallest_prime_factor_table - cannot open " + path);
+			}
+			struct stat st;
+			if (::fstat(fd, &st) == 0 && (size_t)st.st_size == bytes)
+			{
+				header h;
+				if (::pread(fd, &h, sizeof(h), 0) == (ssize_t)sizeof(h)
+					&& h.magic == header::MAGIC && h.limit == limit)
+				{
+					fresh = false;
+				}
+			}
+			// a stale or foreign file may have the right size; truncating
+			//	to nothing first makes the sieve start from zeros
+			if (fresh && (::ftruncate(fd, 0) != 0 || ::ftruncate(fd, (off_t)bytes) != 0))
+			{
+				::close(fd);
+				throw std::runtime_error("num::smallest_prime_factor_table - cannot size " + path);
+			}
+
+			void* m = ::mmap(0, bytes, fresh ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+			::close(fd);
+			if (m == MAP_FAILED)
+			{
+				throw std::runtime_error("num::smallest_prime_factor_table - cannot map " + path);
+			}
+			_mapping = m;
+			_mapped_bytes = bytes;
+			_data = reinterpret_cast<uint32_t*>(static_cast<char*>(m) + sizeof(header));
+
+			if (fresh)
+			{	// the header goes last, so a build cut short is never taken as valid
+				sieve();
+				::msync(m, bytes, MS_SYNC);
+				header* h = static_cast<header*>(m);
+				h->magic = header::MAGIC;
+				h->limit = limit;
+				::msync(m, bytes, MS_SYNC);
+				::mprotect(m, bytes, PROT_READ);
+			}
+		}
+
+		~smallest_prime_factor_table()
+		{
+			if (_mapping) ::munmap(_mapping, _mapped_bytes);
+		}
+
+		uint32_t limit() const { return _limit; }
+
+		// smallest prime factor of 2 <= n <= limit (n itself when n is prime)
+		uint32_t operator[](uint32_t n) const
+		{
+			return (n & 1) ? _data[n >> 1] : 2;
+		}
+
+		bool is_prime(uint32_t n) const
+		{
+			return n >= 2 && n <= _limit && (*this)[n] == n;
+		}
+
+		// prime factors of 1 <= n <= limit in increasing order, with
+		//	repetition.  at most log2(n) lookups.
+		template<typename Container>
+		void factor(uint32_t n, std::back_insert_iterator<Container> out) const
+		{
+			check(n);
+			while ((n & 1) == 0 && n > 1)
+			{
+				out++ = typename Container::value_type(2);
+				n >>= 1;
+			}
+			while (n > 1)
+			{
+				uint32_t p = _data[n >> 1];
+				out++ = typename Container::value_type(p);
+				n /= p;
+			}
+		}
+
+		// call f(n, factors, thread_index) for every lo <= n <= hi, with
+		//	the range split between threads.  factors is reused per thread.
+		template<typename F>
+		void factor_range(uint32_t lo, uint32_t hi, F f, unsigned threads = 0) const
+		{
+			if (lo < 1) lo = 1;
+			if (lo > hi) return;
+			check(hi);
+			parallel_for_chunks<uint64_t>(lo, (uint64_t)hi + 1, threads,
+				[this, &f](uint64_t first, uint64_t end, unsigned t)
+				{
+					std::vector<uint32_t> factors;
+					for (uint64_t n = first; n < end; ++n)
+					{
+						factors.clear();
+						factor((uint32_t)n, std::back_inserter(factors));
+						f((uint32_t)n, factors, t);
+					}
+				}, (uint64_t)4096);
+		}
+
+	private:
+		struct header
+		{
+			enum { MAGIC = 0x31465053 };	// "SPF1"
+			uint32_t magic;
+			uint32_t reserved;
+			uint64_t limit;
+		};
+
+		// one slot per odd number 1, 3, 5, ... <= limit
+		static size_t slots(uint32_t limit) { return ((size_t)limit + 1) / 2; }
+
+		void check(uint32_t n) const
+		{
+			if (n == 0 || n > _limit)
+			{
+				throw std::runtime_error("num::smallest_prime_factor_table - value outside the table.");
+			}
+		}
+
+		// linear sieve over the odd numbers
+		void sieve()
+		{
+			const size_t n = slots(_limit);
+			if (n == 0) return;
+			std::vector<uint32_t> primes;
+			_data[0] = 1;
+			for (size_t i = 1; i < n; ++i)
+			{
+				const uint64_t v = 2 * i + 1;
+				if (_data[i] == 0)
+				{
+					_data[i] = (uint32_t)v;
+					primes.push_back((uint32_t)v);
+				}
+				const uint32_t spf = _data[i];
+				for (size_t j = 0; j < primes.size() && primes[j] <= spf; ++j)
+				{
+					const uint64_t m = primes[j] * v;
+					if (m > _limit) break;
+					_data[m >> 1] = primes[j];
+				}
+			}
+		}
+
+		smallest_prime_factor_table(const smallest_prime_factor_table&);
+		smallest_prime_factor_table& operator=(const smallest_prime_factor_table&);
+
+		uint32_t _limit;
+		std::vector<uint32_t> _storage;
+		uint32_t* _data;
+		void* _mapping;
+		size_t _mapped_bytes;
+	};
+};
+
+#endif // SMALLEST_PRIME_FACTOR_H
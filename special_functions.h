@@ -100,6 +100,8 @@ namespace num
 		return gamma(x)*gamma(y)/gamma(x+y);
 	}
 	
+	// through the gamma function, for real T.  binomial_coefficient in
+	//	binomial.h is exact for integer types.
 	template<typename T>
 	T binomialCoefficient(const T& n, const T& k)
 	{
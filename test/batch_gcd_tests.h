@@ -0,0 +1,80 @@
+/*
+ *  batch_gcd_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef BATCH_GCD_TESTS_H
+#define BATCH_GCD_TESTS_H
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#include "../batch_gcd.h"
+
+namespace batch_gcd_tests
+{
+	void test_product_tree()
+	{
+		unsigned long long x[] = { 2, 3, 5, 7, 11 };
+		num::product_tree<unsigned long long> tree(x, x + 5, 2);
+		assert(tree.height() == 4);
+		assert(tree.level(1).size() == 3 && tree.level(1)[2] == 11);
+		assert(tree.product() == 2310);
+	}
+	
+	void test_batch_gcd()
+	{	// 13*17 shares 13 with 13*19 and 17 with 17*23; 29*31 shares nothing
+		unsigned long long x[] = { 13*17, 29*31, 13*19, 17*23, 37, 41*43 };
+		const unsigned long long expected[] = { 13*17, 1, 13, 17, 1, 1 };
+		for (unsigned threads = 1; threads <= 3; ++threads)
+		{
+			std::vector<unsigned long long> g;
+			num::batch_gcd(x, x + 6, back_inserter(g), threads);
+			assert(g.size() == 6);
+			for (size_t i = 0; i < 6; ++i) assert(g[i] == expected[i]);
+		}
+		
+		// agrees with the pairwise gcds
+		std::vector<unsigned long long> y;
+		for (unsigned long long v = 2; v < 14; ++v) y.push_back(v);
+		std::vector<unsigned long long> g;
+		num::batch_gcd(y.begin(), y.end(), back_inserter(g));
+		for (size_t i = 0; i < y.size(); ++i)
+		{
+			unsigned long long rest = 1;
+			for (size_t j = 0; j < y.size(); ++j) if (j != i) rest *= y[j];
+			assert(g[i] == num::gcd(y[i], rest));
+		}
+	}
+	
+	void catch_zero()
+	{
+		unsigned long long x[] = { 6, 0 };
+		std::vector<unsigned long long> g;
+		bool thrown = false;
+		try { num::batch_gcd(x, x + 2, back_inserter(g)); }
+		catch (std::runtime_error&) { thrown = true; }
+		assert(thrown);
+	}
+	
+	void test_batch()
+	{
+		std::cout << "test batch gcd..." << std::endl;
+		test_product_tree();
+		test_batch_gcd();
+		catch_zero();
+		std::cout << "test batch gcd complete" << std::endl;
+	}
+	
+	void run_tests()
+	{
+		test_batch();
+	}
+};
+
+#endif // BATCH_GCD_TESTS_H
@@ -0,0 +1,190 @@
+/*
+ *  big_integer_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef BIG_INTEGER_TESTS_H
+#define BIG_INTEGER_TESTS_H
+
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../big_integer.h"
+#include "../integer.h"
+#include "../gcd.h"
+#include "../integer_square_root.h"
+#include "../prime_factors.h"
+#include "../rational.h"
+
+namespace big_integer_tests
+{
+	using num::big_integer;
+	
+	// the decimal digits of v, for products that overflow long long
+	std::string decimal(__int128 v)
+	{
+		if (v == 0) return "0";
+		const bool negative = v < 0;
+		std::string s;
+		for (; v != 0; v /= 10) s.insert(s.begin(), char('0' + (negative ? -(v % 10) : v % 10)));
+		return negative ? "-" + s : s;
+	}
+	
+	void test_native_agreement()
+	{	// the same answers as long long, signs and all
+		const long long values[] = { 0, 1, -1, 7, -7, 12345, -99991, 4294967296LL, -4294967297LL, 3037000499LL };
+		for (size_t i = 0; i < 10; ++i)
+		{
+			for (size_t j = 0; j < 10; ++j)
+			{
+				const long long a = values[i], b = values[j];
+				const big_integer x(a), y(b);
+				assert((long long)(x + y) == a + b);
+				assert((long long)(x - y) == a - b);
+				assert((x * y).to_string() == decimal((__int128)a * b));
+				assert((x < y) == (a < b) && (x == y) == (a == b));
+				if (b != 0)
+				{
+					assert((long long)(x / y) == a / b);
+					assert((long long)(x % y) == a % b);
+				}
+			}
+			assert((long long)(big_integer(values[i]) >> 3) == values[i] >> 3);
+			assert((long long)(big_integer(values[i]) << 5) == values[i] * 32);
+			assert(big_integer(values[i]).to_string() == std::to_string(values[i]));
+		}
+		assert(num::even(big_integer(-4)) && num::odd(big_integer(-3)));
+	}
+	
+	void test_strings()
+	{
+		const std::string s = "-123456789012345678901234567890123456789";
+		assert(big_integer(s).to_string() == s);
+		assert(big_integer("0007").to_string() == "7" && big_integer("-0").to_string() == "0");
+		
+		// long enough to split on powers of 10^9 both ways
+		std::string digits = "9";
+		for (int i = 0; i < 5000; ++i) digits += char('0' + (i * 7) % 10);
+		assert(big_integer(digits).to_string() == digits);
+		
+		bool thrown = false;
+		try { big_integer bad("12a4"); }
+		catch (std::runtime_error&) { thrown = true; }
+		assert(thrown);
+	}
+	
+	// x y summed from x times 20 limb slices of y, which stay schoolbook
+	big_integer sliced_product(const big_integer& x, big_integer y)
+	{
+		big_integer r;
+		for (int shift = 0; y != big_integer(0); shift += 640)
+		{
+			big_integer high = y >> 640;
+			r += (x * (y - (high << 640))) << shift;
+			y = high;
+		}
+		return r;
+	}
+	
+	void test_large_products()
+	{	// (10^n - 1)^2 = 10^2n - 2 10^n + 1 at sizes for schoolbook (6
+		//	limbs), Karatsuba (52, 520), Toom-3 (1038) and NTT (2600, 10400)
+		const size_t sizes[] = { 50, 500, 5000, 10000, 25000, 100000 };
+		for (size_t i = 0; i < 6; ++i)
+		{
+			const size_t n = sizes[i];
+			big_integer nines(std::string(n, '9'));
+			std::string expected = std::string(n - 1, '9') + "8" + std::string(n - 1, '0') + "1";
+			assert((nines * nines).to_string() == expected);
+			assert((nines * (nines + big_integer(2)) + big_integer(1)) == (nines + big_integer(1)) * (nines + big_integer(1)));
+		}
+		
+		// Toom-3 on balanced operands of about 1050 limbs, and on an
+		//	operand three times longer, which goes in Toom-3 sized slices
+		big_integer x = num::power(big_integer(7), 12000, num::mult<big_integer>()) - big_integer(1);
+		big_integer y = num::power(big_integer(3), 21000, num::mult<big_integer>()) + big_integer(5);
+		big_integer z = num::power(big_integer(7), 40000, num::mult<big_integer>()) + big_integer(3);
+		assert(x * y == sliced_product(x, y));
+		assert(z * y == sliced_product(y, z) && y * z == z * y);
+		assert((-x) * y == -(x * y));
+	}
+	
+	void test_division()
+	{	// a = q b + r with |r| < |b| at Knuth and Burnikel-Ziegler sizes
+		big_integer b = num::power(big_integer(7), 3000, num::mult<big_integer>()) + big_integer(12345);
+		big_integer q = num::power(big_integer(3), 9000, num::mult<big_integer>()) - big_integer(1);
+		big_integer r = num::power(big_integer(5), 2000, num::mult<big_integer>());
+		big_integer a = q * b + r;
+		assert(a / b == q && a % b == r);
+		assert((-a) / b == -q && (-a) % b == -r);
+		assert(a / (-b) == -q && a % (-b) == r);
+		
+		// large enough for Burnikel-Ziegler to multiply with Toom-3
+		b = num::power(big_integer(7), 14000, num::mult<big_integer>()) + big_integer(1);
+		q = num::power(big_integer(3), 25000, num::mult<big_integer>()) + big_integer(7);
+		r = num::power(big_integer(5), 9000, num::mult<big_integer>());
+		a = q * b + r;
+		assert(a / b == q && a % b == r);
+		
+		big_integer small_b("98765432109876543210987");
+		assert((a / small_b) * small_b + a % small_b == a);
+		
+		bool thrown = false;
+		try { a / big_integer(0); }
+		catch (std::runtime_error&) { thrown = true; }
+		assert(thrown);
+	}
+	
+	void test_library_templates()
+	{
+		// Lehmer gcd
+		big_integer g("123456789012345678901234567890");
+		assert(num::gcd(g * big_integer(97), big_integer("987654321098765432109876543210") * big_integer(97))
+			   == big_integer("873000000087300000008730"));
+		
+		// power and integer square root
+		big_integer p = num::power(big_integer(2), 200, num::mult<big_integer>());
+		assert(num::integer_square_root(p) == num::power(big_integer(2), 100, num::mult<big_integer>()));
+		
+		// 100!
+		big_integer f(1);
+		for (int i = 2; i <= 100; ++i) f *= big_integer(i);
+		assert(f.to_string() == "93326215443944152681699238856266700490715968264381621468592963895217599993229915608941"
+			   "463976156518286253697920827223758251185210916864000000000000000000000000");
+		
+		// rationals that never overflow
+		num::rational<big_integer> h(0);
+		for (int i = 1; i <= 30; ++i) h = h + num::rational<big_integer>(big_integer(1), big_integer(i));
+		assert(h == num::rational<big_integer>(big_integer("9304682830147"), big_integer("2329089562800")));
+		
+		// a 25 digit semiprime is split by ECM
+		std::vector<big_integer> factors;
+		num::prime_factors(big_integer("1000000000039") * big_integer("10000000000037"), back_inserter(factors));
+		assert(factors.size() == 2);
+		assert(factors[0] == big_integer("1000000000039") && factors[1] == big_integer("10000000000037"));
+	}
+	
+	void test_big_integer()
+	{
+		std::cout << "test big integer..." << std::endl;
+		test_native_agreement();
+		test_strings();
+		test_large_products();
+		test_division();
+		test_library_templates();
+		std::cout << "test big integer complete" << std::endl;
+	}
+	
+	void run_tests()
+	{
+		test_big_integer();
+	}
+};
+
+#endif // BIG_INTEGER_TESTS_H
@@ -0,0 +1,71 @@
+/*
+ *  binary_splitting_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef BINARY_SPLITTING_TESTS_H
+#define BINARY_SPLITTING_TESTS_H
+
+#include <cassert>
+#include <iostream>
+#include <string>
+
+#include "../big_integer.h"
+#include "../binary_splitting.h"
+
+namespace binary_splitting_tests
+{
+	using num::big_integer;
+
+	// sum 1/2^n = 2
+	struct geometric_series
+	{
+		long long a(uint64_t) const { return 1; }
+		long long b(uint64_t) const { return 1; }
+		long long p(uint64_t) const { return 1; }
+		long long q(uint64_t n) const { return n == 0 ? 1 : 2; }
+	};
+
+	void test_generic_series()
+	{
+		num::binary_splitting_result<long long> r = num::binary_splitting<long long>(geometric_series(), 0, 10, 1);
+		assert(r.Q == 512 && r.P == 1 && r.B == 1);
+		assert(r.T == 1023);	// 1 + 1/2 + ... + 1/512 = 1023/512
+		assert(num::series_sum(geometric_series(), 20, 1000000LL, 1) == 1999998);
+	}
+
+	void test_constants()
+	{
+		assert(num::e_digits<big_integer>(50).to_string() == "271828182845904523536028747135266249775724709369995");
+		assert(num::pi_digits<big_integer>(50).to_string() == "314159265358979323846264338327950288419716939937510");
+		assert(num::log2_digits<big_integer>(50).to_string() == "69314718055994530941723212145817656807550013436025");
+		assert(num::zeta3_digits<big_integer>(50).to_string() == "120205690315959428539973816151144999076498629234049");
+	}
+
+	void test_threads()
+	{	// the split is the same whichever thread does each half
+		big_integer one = num::pi_digits<big_integer>(5000, 1);
+		assert(num::pi_digits<big_integer>(5000, 4) == one);
+		assert(one.to_string().substr(4991) == "4132604721");
+	}
+
+	void test_binary_splitting()
+	{
+		std::cout << "test binary splitting..." << std::endl;
+		test_generic_series();
+		test_constants();
+		test_threads();
+		std::cout << "test binary splitting complete" << std::endl;
+	}
+
+	void run_tests()
+	{
+		test_binary_splitting();
+	}
+};
+
+#endif // BINARY_SPLITTING_TESTS_H
@@ -0,0 +1,132 @@
+/*
+ *  binomial_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef BINOMIAL_TESTS_H
+#define BINOMIAL_TESTS_H
+
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "../big_integer.h"
+#include "../binomial.h"
+#include "../finite_integral_type.h"
+
+namespace binomial_tests
+{
+	using num::big_integer;
+
+	// rows of Pascal's triangle
+	std::vector<std::vector<big_integer> > pascal(int rows)
+	{
+		std::vector<std::vector<big_integer> > c(rows);
+		for (int n = 0; n < rows; ++n)
+		{
+			c[n].resize(n + 1, big_integer(1));
+			for (int k = 1; k < n; ++k) c[n][k] = c[n - 1][k - 1] + c[n - 1][k];
+		}
+		return c;
+	}
+
+	void test_exact()
+	{
+		std::vector<std::vector<big_integer> > c = pascal(200);
+		for (long long n = 0; n < 63; ++n)
+		{
+			for (long long k = 0; k <= n; ++k)
+			{	// no overflow right up to C(62, 31)
+				assert(big_integer(num::binomial_coefficient(n, k)) == c[n][k]);
+			}
+		}
+		assert(num::binomial_coefficient(10, -1) == 0 && num::binomial_coefficient(10, 11) == 0);
+		for (int n = 150; n < 200; n += 7)
+		{
+			for (int k = 0; k <= n; k += 5)
+			{
+				assert(num::binomial_coefficient(big_integer(n), big_integer(k)) == c[n][k]);
+			}
+		}
+
+		bool thrown = false;
+		try { num::binomial_coefficient(-1, 0); }
+		catch (std::runtime_error&) { thrown = true; }
+		assert(thrown);
+
+		int counts[] = { 2, 3, 4 };
+		assert(num::multinomial_coefficient(counts, counts + 3) == 1260);
+	}
+
+	void test_mod_prime()
+	{
+		std::vector<std::vector<big_integer> > c = pascal(120);
+		const long long primes[] = { 2, 3, 7, 13, 101 };
+		for (int i = 0; i < 5; ++i)
+		{
+			num::binomial_mod_prime<long long> full(primes[i]), partial(primes[i], 3);
+			for (long long n = 0; n < 120; ++n)
+			{
+				for (long long k = 0; k <= n; ++k)
+				{
+					long long expected = (long long)(c[n][k] % big_integer(primes[i]));
+					assert(full(n, k) == expected && partial(n, k) == expected);
+				}
+			}
+		}
+
+		// Lucas' theorem with 18 digit n
+		num::binomial_mod_prime<long long> lucas(1000000007LL, 100000);
+		assert(lucas(1000000000000000000LL, 123456789012LL) == 0);
+		assert(lucas(2000000014LL, 1000000007LL) == 2);
+
+		// the default tables stop well short of a large p
+		num::binomial_mod_prime<long long> large(1000000007LL);
+		assert(large(2000000, 1000) == 253990871);
+		num::binomial_mod_prime<long long> huge(1000000000000000003LL);
+		assert(huge(100000000000000000LL, 5) == 35356750000000000LL);
+		assert(huge(1000, 500) == 80746207319654601LL);
+
+		typedef num::finite_integral_type<long long, 1000003LL> F;
+		assert(num::binomial_residue<F>(1000, 500) == F((long long)(num::binomial<big_integer>(1000, 500) % big_integer(1000003LL))));
+	}
+
+	void test_mod_prime_power()
+	{
+		std::vector<std::vector<big_integer> > c = pascal(120);
+		const long long p[] = { 2, 2, 3, 5, 7 };
+		const unsigned e[] = { 1, 5, 4, 3, 2 };
+		for (int i = 0; i < 5; ++i)
+		{
+			num::binomial_mod_prime_power<long long> b(p[i], e[i]);
+			for (long long n = 0; n < 120; ++n)
+			{
+				for (long long k = 0; k <= n; ++k)
+				{
+					assert(b(n, k) == (long long)(c[n][k] % big_integer(b.modulus())));
+				}
+			}
+		}
+	}
+
+	void test_binomial()
+	{
+		std::cout << "test binomial..." << std::endl;
+		test_exact();
+		test_mod_prime();
+		test_mod_prime_power();
+		std::cout << "test binomial complete" << std::endl;
+	}
+
+	void run_tests()
+	{
+		test_binomial();
+	}
+};
+
+#endif // BINOMIAL_TESTS_H
@@ -0,0 +1,128 @@
+/*
+ *  continued_fraction_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef CONTINUED_FRACTION_TESTS_H
+#define CONTINUED_FRACTION_TESTS_H
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "../big_integer.h"
+#include "../rational.h"
+#include "../continued_fraction.h"
+
+namespace continued_fraction_tests
+{
+	using num::big_integer;
+	typedef num::rational<long long> Q;
+
+	void test_double_conversion()
+	{
+		assert(num::to_rational<long long>(0.75) == Q(3, 4));
+		assert(num::to_rational<long long>(-12.5) == Q(-25, 2));
+		assert(num::to_rational<long long>(0.0) == Q(0));
+		assert(num::to_rational<long long>(0.1) == Q(3602879701896397LL, 36028797018963968LL));
+		assert(num::to_double(Q(-25, 2)) == -12.5);
+		assert(num::to_double(num::to_rational<long long>(0.1)) == 0.1);
+
+		// values out of reach of a long long, but not of big_integer
+		const double tiny = 1e-300, huge = 1e300;
+		assert(num::to_double(num::to_rational<big_integer>(tiny)) == tiny);
+		assert(num::to_double(num::to_rational<big_integer>(huge)) == huge);
+		bool thrown = false;
+		try { num::to_rational<long long>(tiny); }
+		catch (std::runtime_error&) { thrown = true; }
+		assert(thrown);
+	}
+
+	void test_expansion()
+	{
+		std::vector<long long> a;
+		num::continued_fraction(Q(415, 93), std::back_inserter(a));
+		assert(a.size() == 4 && a[0] == 4 && a[1] == 2 && a[2] == 6 && a[3] == 7);
+		assert(num::from_continued_fraction<Q>(a.begin(), a.end()) == Q(415, 93));
+
+		a.clear();
+		num::continued_fraction(Q(-13, 7), std::back_inserter(a));
+		assert(a.size() == 2 && a[0] == -2 && a[1] == 7);
+		assert(num::from_continued_fraction<Q>(a.begin(), a.end()) == Q(-13, 7));
+
+		a.clear();
+		num::continued_fraction<long long>(0.1, std::back_inserter(a));
+		assert(a.size() == 5 && a[0] == 0 && a[1] == 9 && a[2] == 1 && a[3] == 1801439850948197LL && a[4] == 2);
+
+		// pi = [3; 7, 15, 1, 292, ...]
+		const long long pi[] = { 3, 7, 15, 1, 292 };
+		std::vector<Q> c;
+		num::convergents<Q>(pi, pi + 5, std::back_inserter(c));
+		assert(c.size() == 5 && c[0] == Q(3) && c[1] == Q(22, 7) && c[2] == Q(333, 106));
+		assert(c[3] == Q(355, 113) && c[4] == Q(103993, 33102));
+
+		// F(n+1)/F(n) from [1; 1, 1, ...]
+		std::vector<big_integer> ones(200, big_integer(1));
+		num::rational<big_integer> phi = num::from_continued_fraction<num::rational<big_integer> >(ones.begin(), ones.end());
+		assert(std::fabs(num::to_double(phi) - (1 + std::sqrt(5.0)) / 2) < 1e-15);
+	}
+
+	void test_limit_denominator()
+	{
+		const double pi = 3.141592653589793, e = 2.718281828459045;
+		assert(num::limit_denominator(pi, 10LL) == Q(22, 7));
+		assert(num::limit_denominator(pi, 100LL) == Q(311, 99));
+		assert(num::limit_denominator(pi, 1000LL) == Q(355, 113));
+		assert(num::limit_denominator(-pi, 1000LL) == Q(-355, 113));
+		assert(num::limit_denominator(e, 1000LL) == Q(1457, 536));
+		assert(num::limit_denominator(0.1, 1000LL) == Q(1, 10));
+		assert(num::limit_denominator(0.3333, 100LL) == Q(1, 3));
+		assert(num::limit_denominator(1e-10, 1000LL) == Q(0));
+		assert(num::limit_denominator(1e-3, 1000LL) == Q(1, 1000));
+
+		assert(num::limit_denominator(Q(-13, 7), 3LL) == Q(-2));
+		assert(num::limit_denominator(Q(415, 93), 100LL) == Q(415, 93));
+
+		// against a search of every denominator
+		Q x(1000003, 314159);
+		for (long long bound = 1; bound <= 300; ++bound)
+		{
+			Q best = num::limit_denominator(x, bound), closest(0);
+			for (long long q = 1; q <= bound; ++q)
+			{
+				long long p = (long long)std::floor(1000003.0 * q / 314159 + 0.5);
+				Q candidate(p, q), gap = candidate - x, closest_gap = closest - x;
+				if (gap < Q(0)) gap = -gap;
+				if (closest_gap < Q(0)) closest_gap = -closest_gap;
+				if (q == 1 || gap < closest_gap) closest = candidate;
+			}
+			Q gap = best - x, closest_gap = closest - x;
+			if (gap < Q(0)) gap = -gap;
+			if (closest_gap < Q(0)) closest_gap = -closest_gap;
+			assert(best.denominator() <= bound && gap == closest_gap);
+		}
+	}
+
+	void test_continued_fraction()
+	{
+		std::cout << "test continued_fraction..." << std::endl;
+		test_double_conversion();
+		test_expansion();
+		test_limit_denominator();
+		std::cout << "test continued_fraction complete" << std::endl;
+	}
+
+	void run_tests()
+	{
+		test_continued_fraction();
+	}
+};
+
+#endif // CONTINUED_FRACTION_TESTS_H
@@ -0,0 +1,78 @@
+/*
+ *  discrete_log_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef DISCRETE_LOG_TESTS_H
+#define DISCRETE_LOG_TESTS_H
+
+#include <cassert>
+#include <iostream>
+
+#include "../discrete_log.h"
+
+namespace discrete_log_tests
+{
+	template<class T, T BASE>
+	class test
+	{
+	public:
+		typedef typename num::finite_integral_type<T, BASE> FIT;
+		
+		test(const T& generator) : g(generator)
+		{
+			test_baby_step_giant_step();
+			test_pollard_rho_log();
+			test_pohlig_hellman();
+		}
+		
+		FIT power(const T& x) { return num::power(g, x, num::mult<FIT>()); }
+		
+		void test_baby_step_giant_step()
+		{
+			const T order = BASE - T(1);
+			assert(num::baby_step_giant_step(g, FIT(T(1)), order) == T(0));
+			assert(num::baby_step_giant_step(g, power(T(1234)), order) == T(1234));
+			
+			// a tiny table just means more giant steps.
+			num::discrete_log_parameters small(3);
+			assert(num::baby_step_giant_step(g, power(T(1234)), order, small) == T(1234));
+		}
+		
+		void test_pollard_rho_log()
+		{
+			const T order = BASE - T(1);
+			T x = num::pollard_rho_log(g, power(T(4321)), order);
+			assert(power(x) == power(T(4321)));
+		}
+		
+		void test_pohlig_hellman()
+		{
+			assert(num::discrete_log(g, power(T(0))) == T(0));
+			assert(num::discrete_log(g, power(T(777))) == T(777));
+			assert(num::discrete_log(g, power(BASE - T(2))) == BASE - T(2));
+			
+			// force every subgroup through rho.
+			num::discrete_log_parameters rho;
+			rho.rho_threshold = 1;
+			assert(num::discrete_log(g, power(T(777)), rho) == T(777));
+		}
+		
+	private:
+		FIT g;
+	};
+	
+	void run_tests()
+	{
+		std::cout << "test discrete logarithms..." << std::endl;
+		test<int, 40961>(3);
+		test<long long, 1000003>(2);
+		std::cout << "test discrete logarithms complete" << std::endl;
+	}
+};
+
+#endif // DISCRETE_LOG_TESTS_H
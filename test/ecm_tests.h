@@ -0,0 +1,51 @@
+/*
+ *  ecm_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef ECM_TESTS_H
+#define ECM_TESTS_H
+
+#include <cassert>
+#include <iostream>
+
+#include "../ecm.h"
+
+namespace ecm_tests
+{
+	void test_semiprime()
+	{
+		const unsigned long long p = 1000003ULL, q = 998244353ULL;
+		unsigned long long d = num::ecm_factor(p * q, num::ecm_parameters(2000, 0, 200, 1));
+		assert(d == p || d == q);
+		
+		// two factors near 2^31; several threads share the curves
+		const unsigned long long r = 2147483647ULL, s = 2147483629ULL;
+		d = num::ecm_factor(r * s, num::ecm_parameters(5000, 0, 400, 3));
+		assert(d == r || d == s);
+	}
+	
+	void test_prime()
+	{	// every curve fails on a prime
+		assert(num::ecm_factor(1000000007ULL, num::ecm_parameters(500, 0, 8, 2)) == 1000000007ULL);
+	}
+	
+	void test_ecm()
+	{
+		std::cout << "test ecm..." << std::endl;
+		test_semiprime();
+		test_prime();
+		std::cout << "test ecm complete" << std::endl;
+	}
+	
+	void run_tests()
+	{
+		test_ecm();
+	}
+};
+
+#endif // ECM_TESTS_H
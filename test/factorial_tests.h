@@ -0,0 +1,104 @@
+/*
+ *  factorial_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef FACTORIAL_TESTS_H
+#define FACTORIAL_TESTS_H
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <future>
+
+#include "../big_integer.h"
+#include "../factorial.h"
+
+namespace factorial_tests
+{
+	using num::big_integer;
+
+	big_integer naive_factorial(unsigned long long n)
+	{
+		big_integer f(1);
+		for (unsigned long long i = 2; i <= n; ++i) f *= big_integer(i);
+		return f;
+	}
+
+	void test_thread_pool()
+	{
+		num::thread_pool pool(3);
+		assert(pool.size() == 3);
+		std::vector<std::future<int> > squares;
+		for (int i = 0; i < 100; ++i) squares.push_back(pool.submit([i]() { return i * i; }));
+		for (int i = 0; i < 100; ++i) assert(squares[i].get() == i * i);
+	}
+
+	void test_factorial()
+	{
+		assert(num::factorial<unsigned long long>(0) == 1);
+		assert(num::factorial<unsigned long long>(20) == 2432902008176640000ULL);
+		for (unsigned long long n = 0; n < 200; n += 7)
+		{
+			assert(num::factorial<big_integer>(n) == naive_factorial(n));
+		}
+		big_integer f = naive_factorial(20000);
+		assert(num::factorial<big_integer>(20000, 1) == f);
+		assert(num::factorial<big_integer>(20000, 4) == f);
+		assert(num::factorial<big_integer>(100000, 4) == num::factorial<big_integer>(100000, 1));
+	}
+
+	void test_falling_factorial()
+	{
+		assert(num::falling_factorial<unsigned long long>(10, 3) == 720);
+		assert(num::falling_factorial<unsigned long long>(10, 0) == 1);
+		assert(num::falling_factorial<unsigned long long>(3, 4) == 0);
+		assert(num::falling_factorial<big_integer>(5000, 2500) == naive_factorial(5000) / naive_factorial(2500));
+	}
+
+	void test_binomial()
+	{
+		for (unsigned long long n = 0; n < 60; ++n)
+		{
+			unsigned long long c = 1;	// C(n, k) by Pascal's rule across the row
+			for (unsigned long long k = 0; k <= n; ++k)
+			{
+				assert(num::binomial<unsigned long long>(n, k) == c);
+				c = c * (n - k) / (k + 1);
+			}
+			assert(num::binomial<unsigned long long>(n, n + 1) == 0);
+		}
+		big_integer f = naive_factorial(3000);
+		assert(num::binomial<big_integer>(6000, 3000, 4) == naive_factorial(6000) / (f * f));
+	}
+
+	void test_multinomial()
+	{
+		unsigned counts[] = { 3, 5, 0, 7, 1, 9 };
+		assert(num::multinomial<unsigned long long>(counts, counts + 6) == 11779303536000ULL);
+		unsigned pair[] = { 17, 23 };
+		assert(num::multinomial<unsigned long long>(pair, pair + 2) == num::binomial<unsigned long long>(40, 17));
+	}
+
+	void test_factorials()
+	{
+		std::cout << "test factorial..." << std::endl;
+		test_thread_pool();
+		test_factorial();
+		test_falling_factorial();
+		test_binomial();
+		test_multinomial();
+		std::cout << "test factorial complete" << std::endl;
+	}
+
+	void run_tests()
+	{
+		test_factorials();
+	}
+};
+
+#endif // FACTORIAL_TESTS_H
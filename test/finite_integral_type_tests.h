@@ -14,6 +14,8 @@
 
 #include "../finite_integral_type.h"
 #include "../prime_factors.h"
+#include "../big_integer.h"
+#include "../wide_int.h"
 
 namespace finite_integral_type_tests
 {
@@ -168,6 +170,46 @@ namespace finite_integral_type_tests
 		}
 	};
 	
+#if __cplusplus >= 202002L
+	constexpr num::wide_uint<256> secp256k1("115792089237316195423570985008687907853269984665640564039457584007908834671663");
+	
+	// a b - a + b and a / b over a 256 bit prime, against big_integer
+	template<class T>
+	void test_wide_base()
+	{
+		typedef num::finite_integral_type<T, T(secp256k1)> FIT;
+		assert(FIT(T(3)) * FIT(T(5)) + FIT(T(3)) - FIT(T(5)) == FIT(T(13)));
+		assert(-FIT(T(1)) + FIT(T(1)) == FIT(T(0)));
+		
+		const num::big_integer p(secp256k1.to_string());
+		T x(88172645463325252ULL);
+		for (int i = 0; i < 200; ++i)
+		{	// operands spread over [0, p)
+			x = x * T(6364136223846793005ULL) + T(1442695040888963407ULL);
+			T a = x % T(secp256k1);
+			x = x * T(6364136223846793005ULL) + T(1442695040888963407ULL);
+			T b = x % T(secp256k1);
+			if (a.negative()) a = -a;
+			if (b.negative()) b = -b;
+			FIT r = FIT(a) * FIT(b) - FIT(a) + FIT(b);
+			
+			num::big_integer A(a.to_string()), B(b.to_string());
+			num::big_integer expected = ((A * B - A + B) % p + p) % p;
+			assert(num::detail::residue(r).to_string() == expected.to_string());
+			
+			if (b == T(0)) continue;
+			FIT q = FIT(a) / FIT(b);
+			assert(q * FIT(b) == FIT(a));
+		}
+		// 1/2 = (p + 1)/2, and 0 has no inverse
+		assert(FIT(T(2)).invert() == FIT((T(secp256k1) + T(1)) / T(2)));
+		bool thrown = false;
+		try { FIT(T(0)).invert(); }
+		catch (std::runtime_error&) { thrown = true; }
+		assert(thrown);
+	}
+#endif
+	
 	void run_tests()
 	{
 		std::cout << "test finite integral type classes..." << std::endl;
@@ -179,6 +221,11 @@ namespace finite_integral_type_tests
 		// this fails in division.  really it is a trivial example, but interesting!
 		test<int, 1>();
 		
+#if __cplusplus >= 202002L
+		test_wide_base<num::wide_uint<256> >();
+		test_wide_base<num::wide_int<512> >();
+#endif
+		
 		std::cout << "test finite integral type classes completed" << std::endl;
 	}
 };
@@ -28,9 +28,62 @@ namespace gcd_tests
 		std::cout << "test gcd complete" << std::endl;
 	}
 	
+	void test_binary_gcd()
+	{
+		std::cout << "test binary gcd..." << std::endl;
+		assert(num::gcd(0, 0) == 0);
+		assert(num::gcd(0, 12) == 12 && num::gcd(12, 0) == 12);
+		assert(num::gcd(-4, 6) == 2 && num::gcd(4, -6) == 2);
+		assert(num::gcd(48u, 180u) == 12u);
+		assert(num::gcd(1ULL << 63, 3ULL << 40) == 1ULL << 40);
+		assert(num::gcd(18446744073709551557ULL, 18446744073709551533ULL) == 1);	// two primes
+		assert(num::gcd(4294967291ULL * 65537ULL, 4294967279ULL * 65537ULL) == 65537ULL);
+		std::cout << "test binary gcd complete" << std::endl;
+	}
+	
+	void test_lehmer_gcd()
+	{
+		std::cout << "test lehmer gcd..." << std::endl;
+		typedef unsigned __int128 u128;
+		// agrees with Euclid's algorithm on 128 bit values.  Lehmer's is
+		//	called by its tag, since a strict -std=c++17 does not count
+		//	__int128 as an integer and num::gcd then picks Euclid's.
+		unsigned long long seed = 88172645463325252ULL;
+		for (int i = 0; i < 2000; ++i)
+		{
+			seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+			u128 g = seed % 1000003 + 1;
+			u128 x = (((u128)seed << 40) + 12345) * g;
+			u128 y = (((u128)(seed >> (i % 50)) << 30) + 777) * g;
+			const u128 expected = num::detail::gcd(x, y, num::detail::euclid_gcd_tag());
+			assert(num::detail::gcd(x, y, num::detail::lehmer_gcd_tag()) == expected);
+			assert(num::gcd(x, y) == expected);
+		}
+		__int128 a = -((__int128)1 << 100) * 3, b = ((__int128)1 << 90) * 9;
+		assert(num::detail::gcd(a, b, num::detail::lehmer_gcd_tag()) == ((__int128)1 << 90) * 3);
+		assert(num::gcd(a, b) == ((__int128)1 << 90) * 3);
+		std::cout << "test lehmer gcd complete" << std::endl;
+	}
+	
+	void test_extended_gcd()
+	{
+		std::cout << "test extended gcd..." << std::endl;
+		int a, b;
+		assert(num::extended_gcd(91, 28, a, b) == 7);
+		assert(a*91 + b*28 == 7);
+		assert(num::extended_gcd(240, 46, a, b) == 2);
+		assert(a*240 + b*46 == 2);
+		assert(num::modular_inverse(3, 7) == 5);
+		assert(num::modular_inverse(-3, 7) == 2);
+		std::cout << "test extended gcd complete" << std::endl;
+	}
+	
 	void run_tests()
 	{
 		test_gcd();
+		test_binary_gcd();
+		test_lehmer_gcd();
+		test_extended_gcd();
 	}
 };
 
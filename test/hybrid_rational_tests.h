@@ -0,0 +1,115 @@
+/*
+ *  hybrid_rational_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef HYBRID_RATIONAL_TESTS_H
+#define HYBRID_RATIONAL_TESTS_H
+
+#include <cassert>
+#include <climits>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "../big_integer.h"
+#include "../wide_int.h"
+#include "../hybrid_rational.h"
+
+namespace hybrid_rational_tests
+{
+	using num::big_integer;
+	typedef num::hybrid_rational<> Q;
+
+	void test_small()
+	{
+		Q a(6, -4), b(1, 3);
+		assert(a.is_small() && a.numerator() == big_integer(-3) && a.denominator() == big_integer(2));
+		assert(a + b == Q(-7, 6));
+		assert(a - b == Q(-11, 6));
+		assert(a * b == Q(-1, 2));
+		assert(a / b == Q(-9, 2));
+		assert(a + Q(3, 2) == Q(0) && (a + Q(3, 2)).denominator() == big_integer(1));
+		assert(a < b && b > a && a <= a && !(b <= a) && a != b);
+		assert(floor(a) == big_integer(-2) && ceil(a) == big_integer(-1));
+		assert(floor(Q(4, 2)) == big_integer(2) && ceil(Q(4, 2)) == big_integer(2));
+
+		std::ostringstream out;
+		out << a;
+		assert(out.str() == "(-3, 2)");
+
+		bool thrown = false;
+		try { Q(1, 0); }
+		catch (std::runtime_error&) { thrown = true; }
+		assert(thrown);
+		thrown = false;
+		try { a / Q(0); }
+		catch (std::runtime_error&) { thrown = true; }
+		assert(thrown);
+	}
+
+	// the cases where rational<long> silently wraps
+	void test_promotion()
+	{
+		const long long big = 3037000500LL;	// big * big passes LLONG_MAX
+		Q a(big);
+		Q square = a * a;
+		assert(!square.is_small());
+		assert(square.numerator() == big_integer(big) * big_integer(big));
+		assert(square / a == a && (square / a).is_small());
+
+		Q sum = Q(1, 1000000007) + Q(1, 1000000009);
+		assert(sum.is_small() && sum == Q(2000000016LL, 1000000016000000063LL));
+		Q wide = Q(1, LLONG_MAX) + Q(1, LLONG_MAX - 1);
+		assert(!wide.is_small());
+		assert(wide.denominator() == big_integer(LLONG_MAX) * big_integer(LLONG_MAX - 1));
+		Q back = wide - Q(1, LLONG_MAX - 1);
+		assert(back.is_small() && back == Q(1, LLONG_MAX));
+
+		assert(Q(LLONG_MAX) + Q(1) > Q(LLONG_MAX));
+		assert(!(Q(LLONG_MAX) + Q(1)).is_small());
+		assert(-Q(LLONG_MIN) == Q(LLONG_MAX) + Q(1));
+		assert(Q(LLONG_MIN, 2).is_small() && Q(LLONG_MIN, 2) == Q(LLONG_MIN / 2));
+
+		// the harmonic numbers outgrow 64 bits at H(47)
+		Q h;
+		big_integer n(0), d(1);
+		for (long long i = 1; i <= 60; ++i)
+		{
+			h += Q(1, i);
+			n = n * big_integer(i) + d;
+			d *= big_integer(i);
+		}
+		assert(!h.is_small() && h == Q(n, d));
+		assert(Q(1, 60) < h && h - Q(4) > Q(0) && h - Q(5) < Q(0));
+	}
+
+	void test_wide()
+	{
+		typedef num::hybrid_rational<num::wide_int<256> > W;
+		W a(LLONG_MAX, 3);
+		W b = a * a * a;
+		assert(!b.is_small());
+		assert(b / a / a == a && (b / a / a).is_small());
+	}
+
+	void test_hybrid_rational()
+	{
+		std::cout << "test hybrid_rational..." << std::endl;
+		test_small();
+		test_promotion();
+		test_wide();
+		std::cout << "test hybrid_rational complete" << std::endl;
+	}
+
+	void run_tests()
+	{
+		test_hybrid_rational();
+	}
+};
+
+#endif // HYBRID_RATIONAL_TESTS_H
@@ -13,6 +13,8 @@
 #include <stdexcept>
 #include <iostream>
 
+#include "../big_integer.h"
+#include "../wide_int.h"
 #include "../integer_square_root.h"
 
 namespace integer_square_root_tests
@@ -37,7 +39,7 @@ namespace integer_square_root_tests
 		assert(num::integer_square_root(0) == 0);
 		assert(num::integer_square_root(1) == 1);
 		assert(num::integer_square_root(2) == 1);
-		assert(num::integer_square_root(3) == 2);
+		assert(num::integer_square_root(3) == 1);
 		assert(num::integer_square_root(7) == 2);
 		assert(num::integer_square_root(9) == 3);
 		assert(num::integer_square_root(30) == 5);
@@ -45,12 +47,68 @@ namespace integer_square_root_tests
 		assert(num::integer_square_root(36) == 6);
 		assert(num::integer_square_root(10001) == 100);
 		assert(num::integer_square_root(100000003) == 10000);
+		assert(num::integer_square_root(18446744073709551615ULL) == 4294967295ULL);
+		assert(num::integer_square_root(18446744065119617025ULL) == 4294967295ULL);
+		assert(num::integer_square_root(18446744065119617024ULL) == 4294967294ULL);
+		for (unsigned long long r = 1; r < 1ULL << 32; r = r * 3 + 1)
+		{	// exact at every square and one below it
+			assert(num::integer_square_root(r * r) == r);
+			assert(num::integer_square_root(r * r - 1) == r - 1);
+		}
 		std::cout << "test integer square root complete." << std::endl;
 	}
 	
+	void test_wide_square_root()
+	{	// Zimmermann's recursion on big_integer and wide_uint
+		num::big_integer r(1);
+		for (int i = 0; i < 400; ++i)
+		{
+			r = r * num::big_integer(12345) + num::big_integer(i);
+			num::big_integer t = r * r;
+			assert(num::integer_square_root(t) == r);
+			assert(num::integer_square_root(t - num::big_integer(1)) == r - num::big_integer(1));
+			assert(num::integer_square_root(t + r + r) == r);
+		}
+		num::wide_uint<256> w = ~num::wide_uint<256>();
+		assert(num::integer_square_root(w) == ~num::wide_uint<256>() >> 128);
+	}
+	
+	void test_kth_root()
+	{
+		assert(num::integer_kth_root(26, 3) == 2 && num::integer_kth_root(27, 3) == 3);
+		assert(num::integer_kth_root(18446744073709551615ULL, 3) == 2642245ULL);
+		assert(num::integer_kth_root(18446744073709551615ULL, 63) == 2);
+		assert(num::integer_kth_root(18446744073709551615ULL, 64) == 1);
+		num::big_integer b = num::power(num::big_integer(1234567), 11, num::mult<num::big_integer>());
+		assert(num::integer_kth_root(b, 11) == num::big_integer(1234567));
+		assert(num::integer_kth_root(b - num::big_integer(1), 11) == num::big_integer(1234566));
+	}
+	
+	void test_perfect_powers()
+	{
+		long long root = 0;
+		assert(num::is_perfect_square(1522756LL, &root) && root == 1234);
+		assert(!num::is_perfect_square(1522757LL));
+		assert(!num::is_perfect_square(-4LL));
+		int squares = 0;
+		for (int i = 0; i < 10000; ++i) if (num::is_perfect_square(i)) ++squares;
+		assert(squares == 100);
+		
+		long long base = 0;
+		unsigned exponent = 0;
+		assert(num::is_perfect_power(3486784401LL, &base, &exponent) && base == 3 && exponent == 20);
+		assert(!num::is_perfect_power(1000000007LL));
+		num::big_integer b, p = num::power(num::big_integer(12), 35, num::mult<num::big_integer>());
+		assert(num::is_perfect_power(p, &b, &exponent) && b == num::big_integer(12) && exponent == 35);
+		assert(!num::is_perfect_power(p + num::big_integer(1)));
+	}
+	
 	void run_tests()
 	{
 		test_integer_square_root();
+		test_wide_square_root();
+		test_kth_root();
+		test_perfect_powers();
 	}
 };
 
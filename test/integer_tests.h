@@ -38,6 +38,9 @@ namespace integer_tests
 			test_sub();
 			test_mult();
 			test_div();
+			test_power();
+			test_power_sliding_window();
+			test_fixed_base_power();
 		}
 
 		void test_successor()
@@ -188,6 +191,62 @@ namespace integer_tests
 		assert(num::div<T>()(T(0), T(1)) == T(0));
 		assert(catch_div_error());
 	}
+	
+	void test_power()
+	{
+		assert(num::power(T(3), 0, num::mult<T>()) == T(1));
+		assert(num::power(T(3), 5, num::mult<T>()) == T(243));
+		assert(num::power(T(5), 7, num::add<T>()) == T(35));
+	}
+	
+	void test_power_sliding_window()
+	{
+		for (int n = 0; n < 20; ++n)
+		{
+			for (size_t k = 0; k < 5; ++k)
+			{
+				assert(num::power_sliding_window(T(3), n, num::mult<T>(), k) == num::power(T(3), n, num::mult<T>()));
+			}
+		}
+		// any associative operation will do
+		assert(num::power_sliding_window(T(7), 1234567, num::add<T>(), 4) == T(7*1234567));
+	}
+	
+	void test_fixed_base_power()
+	{
+		// 3^15 is the largest power a 4 bit table holds, and it fits a T
+		num::fixed_base_power<num::mult<T> > three(T(3), 4);
+		for (int n = 0; n < 16; ++n)
+		{
+			assert(three(n) == num::power(T(3), n, num::mult<T>()));
+		}
+		// a 20 bit table has to work modulo a prime to stay in range
+		typedef num::modular_mult<unsigned long long> mod_mult;
+		const mod_mult mod(1000000007ULL);
+		num::fixed_base_power<mod_mult> three_mod(3ULL, 20, 4, mod);
+		for (int n = 0; n < (1 << 20); n += 997)
+		{
+			assert(three_mod(n) == num::power(3ULL, n, mod));
+		}
+		assert(three_mod((1 << 20) - 1) == num::power(3ULL, (1 << 20) - 1, mod));
+		num::fixed_base_power<num::add<T> > seven(T(7), 24, 5);
+		assert(seven(1234567) == T(7*1234567));
+		assert(catch_fixed_base_overflow());
+	}
+	
+	bool catch_fixed_base_overflow()
+	{
+		try
+		{
+			num::fixed_base_power<num::mult<T> > small(T(3), 4);
+			small(1 << 10);
+			return false;
+		}
+		catch(std::runtime_error e)
+		{
+			return true;
+		}
+	}
 	};
 	void run_tests()
 	{
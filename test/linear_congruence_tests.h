@@ -0,0 +1,93 @@
+/*
+ *  linear_congruence_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef LINEAR_CONGRUENCE_TESTS_H
+#define LINEAR_CONGRUENCE_TESTS_H
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#include "../linear_congruence.h"
+
+namespace linear_congruence_tests
+{
+	template<class T>
+	class test
+	{
+	public:
+		test(const T& multiplier, const T& increment) : a(multiplier), c(increment)
+		{
+			test_step();
+			test_discard();
+			test_streams();
+		}
+		
+		// walk the generator one value at a time
+		T walk(T x, int n)
+		{
+			for (int i = 0; i < n; ++i) x = num::linear_congruential_increment(x, a, c);
+			return x;
+		}
+		
+		void test_step()
+		{
+			T seed(12345);
+			assert(num::linear_congruential_step(seed, a, c, 0) == seed);
+			assert(num::linear_congruential_step(seed, a, c, 1) == walk(seed, 1));
+			assert(num::linear_congruential_step(seed, a, c, 1000) == walk(seed, 1000));
+			assert(num::linear_congruential_step(seed, a, c, 1023) == walk(seed, 1023));
+		}
+		
+		void test_discard()
+		{
+			num::linear_congruential_generator<T> g(T(42), a, c);
+			num::linear_congruential_generator<T> h(T(42), a, c);
+			g.discard(777);
+			for (int i = 0; i < 777; ++i) h();
+			assert(g.state() == h.state());
+			assert(g() == h());
+		}
+		
+		void test_streams()
+		{
+			num::linear_congruential_streams<T> s(T(7), a, c, 100);
+			std::vector<num::linear_congruential_generator<T> > all = s.streams(4);
+			
+			// stream k picks up exactly where stream k-1 stops
+			num::linear_congruential_generator<T> serial(T(7), a, c);
+			for (size_t k = 0; k < all.size(); ++k)
+			{
+				num::linear_congruential_generator<T> sk = s.stream(k);
+				assert(sk.state() == all[k].state());
+				for (int i = 0; i < 100; ++i)
+				{
+					assert(sk() == serial());
+				}
+			}
+		}
+		
+	private:
+		T a;
+		T c;
+	};
+	
+	void run_tests()
+	{
+		std::cout << "test linear congruential generators..." << std::endl;
+		// minimal standard generator
+		typedef num::finite_integral_type<long long, 2147483647> MINSTD;
+		test<MINSTD>(MINSTD(16807), MINSTD(0));
+		// numerical recipes generator, modulo 2^32 by unsigned wraparound
+		test<unsigned>(1664525u, 1013904223u);
+		std::cout << "test linear congruential generators complete" << std::endl;
+	}
+};
+
+#endif // LINEAR_CONGRUENCE_TESTS_H
@@ -8,6 +8,25 @@
 #include "rational_tests.h"
 #include "finite_integral_type_tests.h"
 #include "polynomial_tests.h"
+#include "discrete_log_tests.h"
+#include "modular_batch_tests.h"
+#include "residue_number_system_tests.h"
+#include "linear_congruence_tests.h"
+#include "prime_sieve_tests.h"
+#include "smallest_prime_factor_tests.h"
+#include "multiplicative_functions_tests.h"
+#include "prime_counting_tests.h"
+#include "ecm_tests.h"
+#include "batch_gcd_tests.h"
+#include "quadratic_residue_tests.h"
+#include "big_integer_tests.h"
+#include "wide_int_tests.h"
+#include "binary_splitting_tests.h"
+#include "factorial_tests.h"
+#include "binomial_tests.h"
+#include "hybrid_rational_tests.h"
+#include "rational_algorithms_tests.h"
+#include "continued_fraction_tests.h"
 
 int main (int argc, char * const argv[]) 
 {
@@ -19,5 +38,24 @@ int main (int argc, char * const argv[])
 	rational_tests::run_tests();
 	finite_integral_type_tests::run_tests();
 	polynomial_tests::run_tests();
+	discrete_log_tests::run_tests();
+	modular_batch_tests::run_tests();
+	residue_number_system_tests::run_tests();
+	linear_congruence_tests::run_tests();
+	prime_sieve_tests::run_tests();
+	smallest_prime_factor_tests::run_tests();
+	multiplicative_functions_tests::run_tests();
+	prime_counting_tests::run_tests();
+	ecm_tests::run_tests();
+	batch_gcd_tests::run_tests();
+	quadratic_residue_tests::run_tests();
+	big_integer_tests::run_tests();
+	wide_int_tests::run_tests();
+	binary_splitting_tests::run_tests();
+	factorial_tests::run_tests();
+	binomial_tests::run_tests();
+	hybrid_rational_tests::run_tests();
+	rational_algorithms_tests::run_tests();
+	continued_fraction_tests::run_tests();
     return 0;
 }
@@ -0,0 +1,83 @@
+/*
+ *  modular_batch_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef MODULAR_BATCH_TESTS_H
+#define MODULAR_BATCH_TESTS_H
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#include "../modular_batch.h"
+#include "../finite_integral_type.h"
+
+namespace modular_batch_tests
+{
+	// compare every kernel against plain % arithmetic.  the odd length 
+	//	exercises the vector loops and the scalar tail.
+	void test_kernels(uint32_t p)
+	{
+		num::modular_batch batch(p);
+		const size_t n = 101;
+		
+		std::vector<uint32_t> a(n), b(n), c(n);
+		uint64_t x = 88172645463325252ULL;
+		for (size_t i = 0; i < n; ++i)
+		{
+			x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+			a[i] = (uint32_t)(x % p);
+			b[i] = (uint32_t)((x >> 32) % p);
+			c[i] = (uint32_t)((x >> 16) % p);
+		}
+		a[0] = p - 1; b[0] = p - 1;
+		
+		std::vector<uint32_t> sum = batch.add(a, b);
+		std::vector<uint32_t> product = batch.multiply(a, b);
+		std::vector<uint32_t> scaled = batch.scale(12345, a);
+		std::vector<uint32_t> fma(n);
+		batch.multiply_add(&a[0], &b[0], &c[0], &fma[0], n);
+		
+		uint64_t dot = 0;
+		for (size_t i = 0; i < n; ++i)
+		{
+			assert(sum[i] == (a[i] + (uint64_t)b[i]) % p);
+			assert(product[i] == (uint64_t)a[i] * b[i] % p);
+			assert(scaled[i] == 12345ULL * a[i] % p);
+			assert(fma[i] == ((uint64_t)a[i] * b[i] + c[i]) % p);
+			dot = (dot + (uint64_t)a[i] * b[i]) % p;
+		}
+		assert(batch.dot(a, b) == dot);
+	}
+	
+	void test_residue_conversion()
+	{
+		typedef num::finite_integral_type<int, 19> FIT;
+		std::vector<FIT> v;
+		v.push_back(FIT(3)); v.push_back(-FIT(3)); v.push_back(FIT(18));
+		
+		std::vector<uint32_t> r = num::to_residues(v.begin(), v.end());
+		assert(r[0] == 3 && r[1] == 16 && r[2] == 18);
+		
+		std::vector<FIT> w;
+		num::from_residues<FIT>(num::modular_batch(19).multiply(r, r), std::back_inserter(w));
+		assert(w[0] == FIT(9) && w[1] == FIT(9) && w[2] == FIT(1));
+	}
+	
+	void run_tests()
+	{
+		std::cout << "test modular batch kernels..." << std::endl;
+		test_kernels(3);
+		test_kernels(998244353);
+		test_kernels(2147483647);
+		test_residue_conversion();
+		std::cout << "test modular batch kernels complete" << std::endl;
+	}
+};
+
+#endif // MODULAR_BATCH_TESTS_H
@@ -0,0 +1,83 @@
+/*
+ *  multiplicative_functions_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef MULTIPLICATIVE_FUNCTIONS_TESTS_H
+#define MULTIPLICATIVE_FUNCTIONS_TESTS_H
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#include "../multiplicative_functions.h"
+#include "../gcd.h"
+
+namespace multiplicative_functions_tests
+{
+	void test_single_values()
+	{
+		assert(num::euler_totient<long long>(1) == 1);
+		assert(num::euler_totient<long long>(36) == 12);
+		assert(num::euler_totient<long long>(97) == 96);
+		assert(num::mobius<int>(1) == 1);
+		assert(num::mobius<int>(30) == -1);
+		assert(num::mobius<int>(12) == 0);
+		assert(num::divisor_count<int>(36) == 9);
+		assert(num::divisor_sum<long long>(28) == 56);
+		assert(num::divisor_sum<long long>(6, 2) == 50);
+		assert(num::divisor_sum<long long>(6, 0) == 4);
+	}
+	
+	void test_ranges()
+	{
+		std::vector<long long> phi = num::euler_totient_range<long long>(1, 2000);
+		std::vector<int> mu = num::mobius_range<int>(1, 2000);
+		std::vector<int> d = num::divisor_count_range<int>(1, 2000);
+		std::vector<long long> sigma = num::divisor_sum_range<long long>(1, 2000);
+		assert(phi.size() == 2000);
+		for (int n = 1; n <= 2000; ++n)
+		{
+			// phi by its definition
+			long long coprime = 0;
+			for (int k = 1; k <= n; ++k) if (num::gcd(k, n) == 1) ++coprime;
+			assert(phi[n-1] == coprime);
+			assert(mu[n-1] == num::mobius<int>(n));
+			assert(d[n-1] == num::divisor_count<int>(n));
+			assert(sigma[n-1] == num::divisor_sum<long long>(n));
+		}
+	}
+	
+	void test_segmented()
+	{
+		// small blocks far from zero against the single value versions
+		const uint64_t lo = 1000000000000ULL, hi = lo + 1000;
+		uint64_t next = lo;
+		num::multiplicative_sieve<long long>(lo, hi, num::totient_of_prime_power<long long>(),
+			[&next](uint64_t first, const std::vector<long long>& values)
+			{
+				assert(first == next && values.size() <= 64);
+				for (size_t i = 0; i < values.size(); ++i)
+				{
+					assert(values[i] == num::euler_totient<long long>(first + i));
+				}
+				next += values.size();
+			}, 64);
+		assert(next == hi + 1);
+	}
+	
+	void run_tests()
+	{
+		std::cout << "test multiplicative functions..." << std::endl;
+		test_single_values();
+		test_ranges();
+		test_segmented();
+		std::cout << "test multiplicative functions complete" << std::endl;
+	}
+};
+
+#endif // MULTIPLICATIVE_FUNCTIONS_TESTS_H
@@ -0,0 +1,54 @@
+/*
+ *  prime_counting_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef PRIME_COUNTING_TESTS_H
+#define PRIME_COUNTING_TESTS_H
+
+#include <cassert>
+#include <iostream>
+
+#include "../prime_counting.h"
+#include "../prime_sieve.h"
+
+namespace prime_counting_tests
+{
+	void test_against_sieve()
+	{
+		num::prime_sieve sieve(100000);
+		for (uint64_t x = 0; x < 2000; ++x)
+		{
+			assert(num::prime_count(x, 1) == sieve.count(0, x, 1));
+		}
+		for (uint64_t x = 2000; x <= 100000; x += 997)
+		{
+			assert(num::prime_count(x, 1) == sieve.count(0, x, 1));
+		}
+	}
+	
+	void test_known_values()
+	{
+		assert(num::prime_count(1000000000ULL) == 50847534ULL);
+		// large enough that the update passes are split between threads
+		assert(num::prime_count(10000000000ULL, 3) == 455052511ULL);
+		
+		assert(num::prime_sum<unsigned long long>(10) == 17);
+		assert(num::prime_sum<unsigned long long>(1000000) == 37550402023ULL);
+		assert(num::prime_sum<unsigned long long>(1000000000ULL, 2) == 24739512092254535ULL);
+	}
+	
+	void run_tests()
+	{
+		std::cout << "test prime counting..." << std::endl;
+		test_against_sieve();
+		test_known_values();
+		std::cout << "test prime counting complete" << std::endl;
+	}
+};
+
+#endif // PRIME_COUNTING_TESTS_H
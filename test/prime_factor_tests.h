@@ -16,6 +16,9 @@
 #include <stdexcept>
 
 #include "../integer.h"
+#include "../prime_factors.h"
+#include "../big_integer.h"
+#include "../wide_int.h"
 
 namespace prime_factor_tests
 {
@@ -57,10 +60,92 @@ namespace prime_factor_tests
 	void test_is_prime()
 	{
 		assert(num::is_prime(52579));
-		assert(num::is_prime(1));
+		assert(!num::is_prime(1));
+		assert(!num::is_prime(0));
+		assert(!num::is_prime(-7));
+		assert(num::is_prime(2));
 		assert(!num::is_prime(1001));
+		
+		// 64 bit primes, a carmichael number and strong pseudoprimes
+		assert(num::is_prime(18446744073709551557ULL));
+		assert(num::is_prime(1000000000000000003LL));
+		assert(num::is_prime(2305843009213693951ULL));
+		assert(!num::is_prime(561));
+		assert(!num::is_prime(3215031751LL));
+		assert(!num::is_prime(3825123056546413051LL));
+		assert(!num::is_prime(18446743979220271189ULL));
 	}
 
+	void test_pollard_brent()
+	{
+		typedef unsigned long long T;
+		// two 32 bit primes: hopeless by trial division
+		T n = 4294967291ULL * 4294967279ULL;
+		T d = num::pollard_brent(n);
+		assert(d == 4294967291ULL || d == 4294967279ULL);
+		
+		std::vector<T> factors;
+		num::prime_factors(n, back_inserter(factors));
+		assert(factors.size() == 2 && factors[0] == 4294967279ULL && factors[1] == 4294967291ULL);
+		
+		// repeated and mixed size factors come out sorted
+		factors.clear();
+		T m = 2ULL * 2 * 3 * 1009 * 1009 * 999983ULL * 1000003ULL;
+		num::prime_factors(m, back_inserter(factors));
+		T expected[] = { 2, 2, 3, 1009, 1009, 999983, 1000003 };
+		assert(factors == std::vector<T>(expected, expected + 7));
+		
+		factors.clear();
+		num::prime_factors(4611686014132420609ULL, back_inserter(factors));	// (2^31-1)^2
+		assert(factors.size() == 2 && factors[0] == 2147483647ULL && factors[1] == 2147483647ULL);
+	}
+	
+	// 128 bit operands against the exact product in 256 bits
+	void test_multiply_mod128()
+	{
+		typedef unsigned __int128 u128;
+		typedef num::wide_uint<256> W;
+		const u128 a = ((u128)1 << 105) + 3, b = ((u128)1 << 104) + 5, m = ((u128)1 << 110) + 27;
+		assert(num::multiply_mod(a, b, m) == (((u128)13365938225152ULL << 64) | 15));
+		
+		unsigned long long x = 88172645463325252ULL;
+		for (int i = 0; i < 2000; ++i)
+		{
+			u128 v[3];
+			for (int j = 0; j < 3; ++j)
+			{	// xorshift, with the moduli spread over every length
+				x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+				unsigned long long y = x;
+				x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+				v[j] = (((u128)y << 64) | x) >> (j == 2 ? i % 127 : 0);
+			}
+			if (v[2] == 0) continue;
+			W p = W((unsigned long long)(v[0] >> 64)) << 64 | W((unsigned long long)v[0]);
+			W q = W((unsigned long long)(v[1] >> 64)) << 64 | W((unsigned long long)v[1]);
+			W n = W((unsigned long long)(v[2] >> 64)) << 64 | W((unsigned long long)v[2]);
+			W r = p * q % n;
+			u128 expected = ((u128)r.limbs[1] << 64) | r.limbs[0];
+			assert(num::multiply_mod(v[0], v[1], v[2]) == expected);
+		}
+		assert(num::multiply_mod((__int128)-7, (__int128)5, (__int128)11) == -2);
+	}
+	
+	// wide types go through the strong probable prime test
+	void test_wide_prime()
+	{
+		typedef unsigned __int128 u128;
+		assert(num::is_prime(((u128)1 << 127) - 1) && !num::is_prime(((u128)1 << 127) + 1));
+		
+		const char* secp256k1 = "115792089237316195423570985008687907853269984665640564039457584007908834671663";
+		assert(num::is_prime(num::big_integer(secp256k1)) && !num::is_prime(num::big_integer(secp256k1) + num::big_integer(2)));
+		assert(num::is_prime(num::wide_uint<256>(secp256k1)) && !num::is_prime(num::wide_uint<256>(secp256k1) - num::wide_uint<256>(2)));
+		
+		// three 30 bit primes, about 2^90
+		std::vector<__int128> factors;
+		num::prime_factors((__int128)1000000007 * 998244353 * 1000000009, back_inserter(factors));
+		assert(factors.size() == 3 && factors[0] == 998244353 && factors[1] == 1000000007 && factors[2] == 1000000009);
+	}
+	
 	void test_prime_factors()
 	{
 		std::cout << "test prime_factors..." << std::endl;
@@ -75,6 +160,9 @@ namespace prime_factor_tests
 		assert(verify_prime_factor_result(52579));
 		
 		test_is_prime();
+		test_pollard_brent();
+		test_multiply_mod128();
+		test_wide_prime();
 	
 		std::cout << "test prime_factors complete" << std::endl;
 	
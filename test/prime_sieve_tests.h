@@ -0,0 +1,88 @@
+/*
+ *  prime_sieve_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef PRIME_SIEVE_TESTS_H
+#define PRIME_SIEVE_TESTS_H
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <iterator>
+
+#include "../prime_sieve.h"
+
+namespace prime_sieve_tests
+{
+	// the obvious sieve to check against
+	std::vector<uint64_t> reference_primes(uint64_t lo, uint64_t hi)
+	{
+		std::vector<bool> composite(hi + 1, false);
+		std::vector<uint64_t> primes;
+		for (uint64_t i = 2; i <= hi; ++i)
+		{
+			if (composite[i]) continue;
+			if (i >= lo) primes.push_back(i);
+			for (uint64_t j = i * i; j <= hi; j += i) composite[j] = true;
+		}
+		return primes;
+	}
+	
+	void test_primes()
+	{
+		// a tiny segment forces many segments and carried multiples
+		num::prime_sieve sieve(200000, 64);
+		uint64_t ranges[][2] = { {0, 1}, {0, 2}, {0, 30}, {0, 100}, {7, 7}, {8, 10}, 
+			{29, 31}, {1000, 5000}, {0, 200000}, {199000, 200000} };
+		for (size_t i = 0; i < sizeof(ranges)/sizeof(ranges[0]); ++i)
+		{
+			uint64_t lo = ranges[i][0], hi = ranges[i][1];
+			std::vector<uint64_t> expected = reference_primes(lo, hi);
+			
+			std::vector<uint64_t> found;
+			sieve.primes(lo, hi, std::back_inserter(found));
+			assert(found == expected);
+			
+			std::vector<uint64_t> streamed(sieve.begin(lo, hi), sieve.end());
+			assert(streamed == expected);
+			
+			assert(sieve.count(lo, hi, 1) == expected.size());
+			assert(sieve.count(lo, hi, 3) == expected.size());
+		}
+	}
+	
+	void test_parallel_for_each_prime()
+	{
+		num::prime_sieve sieve(100000, 128);
+		std::vector<uint64_t> sums(4, 0);
+		sieve.parallel_for_each_prime(0, 100000, [&sums](uint64_t p, unsigned t) { sums[t] += p; }, 4);
+		uint64_t total = sums[0] + sums[1] + sums[2] + sums[3];
+		assert(total == 454396537ULL);	// sum of primes below 10^5
+	}
+	
+	void test_counts()
+	{
+		num::prime_sieve sieve(10000000);
+		assert(sieve.count(10000000) == 664579);
+		
+		std::vector<int> small;
+		num::primes_up_to(30, std::back_inserter(small));
+		assert(small.size() == 10 && small.back() == 29);
+	}
+	
+	void run_tests()
+	{
+		std::cout << "test prime sieve..." << std::endl;
+		test_primes();
+		test_parallel_for_each_prime();
+		test_counts();
+		std::cout << "test prime sieve complete" << std::endl;
+	}
+};
+
+#endif // PRIME_SIEVE_TESTS_H
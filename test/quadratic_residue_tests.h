@@ -0,0 +1,118 @@
+/*
+ *  quadratic_residue_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef QUADRATIC_RESIDUE_TESTS_H
+#define QUADRATIC_RESIDUE_TESTS_H
+
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+
+#include "../quadratic_residue.h"
+
+namespace quadratic_residue_tests
+{
+	void test_jacobi()
+	{
+		assert(num::jacobi(1001, 9907) == -1);
+		assert(num::jacobi(19, 45) == 1);
+		assert(num::jacobi(8, 21) == -1);
+		assert(num::jacobi(5, 21) == 1);
+		assert(num::jacobi(6, 15) == 0);
+		assert(num::jacobi(-1, 7) == -1 && num::jacobi(-1, 13) == 1);
+		
+		// Euler's criterion on every residue of a small prime
+		const long long p = 10007;
+		for (long long a = 0; a < p; ++a)
+		{
+			long long e = num::power(a, (p - 1) / 2, num::modular_mult<long long>(p));
+			assert(num::legendre(a, p) == (e == p - 1 ? -1 : int(e)));
+		}
+		
+		// the division based path for wide types agrees
+		typedef unsigned __int128 u128;
+		assert(num::jacobi((u128)1001, (u128)9907) == -1);
+		assert(num::jacobi((u128)19, (u128)45) == 1);
+	}
+	
+	template<typename Root>
+	void check_roots(long long p, Root root)
+	{
+		for (long long a = 0; a < p; a += 1 + a / 7)
+		{
+			if (num::legendre(a, p) < 0) continue;
+			long long r = root(a, p);
+			assert(r <= p - r && num::multiply_mod(r, r, p) == a);
+		}
+	}
+	
+	struct tonelli { long long operator()(long long a, long long p) const { return num::tonelli_shanks(a, p); } };
+	struct cipolla { long long operator()(long long a, long long p) const { return num::cipolla(a, p); } };
+	struct best { long long operator()(long long a, long long p) const { return num::modular_square_root(a, p); } };
+	
+	void test_square_roots()
+	{
+		// 3 mod 4, 5 mod 8, 1 mod 8, and 2^16 + 1 where p - 1 is all twos
+		const long long primes[] = { 10007, 10009, 10177, 65537, 998244353 };
+		for (size_t i = 0; i < sizeof(primes) / sizeof(primes[0]); ++i)
+		{
+			check_roots(primes[i], tonelli());
+			check_roots(primes[i], cipolla());
+			check_roots(primes[i], best());
+		}
+		
+		// a 61 bit prime
+		const unsigned long long big = 2305843009213693951ULL, a = 123456789123456789ULL;
+		unsigned long long square = num::multiply_mod(a, a, big);
+		unsigned long long r = num::modular_square_root(square, big);
+		assert(r == a || r == big - a);
+	}
+	
+	void test_finite_integral_type()
+	{
+		typedef num::finite_integral_type<long long, 1000003> FIT;
+		FIT a(2);
+		assert(num::is_quadratic_residue(FIT(4)));
+		FIT r = num::modular_square_root(FIT(5) * FIT(5));
+		assert(r == FIT(5) || r == -FIT(5));
+		assert(num::tonelli_shanks(FIT(49)) == FIT(7));
+		assert(num::cipolla(FIT(49)) == FIT(7));
+		assert(num::legendre(a) == num::jacobi(2LL, 1000003LL));
+	}
+	
+	void catch_non_residue()
+	{
+		bool thrown = false;
+		try { num::modular_square_root(3LL, 7LL); }
+		catch (std::runtime_error&) { thrown = true; }
+		assert(thrown);
+		
+		thrown = false;
+		try { num::jacobi(3, 8); }
+		catch (std::runtime_error&) { thrown = true; }
+		assert(thrown);
+	}
+	
+	void test_quadratic_residue()
+	{
+		std::cout << "test quadratic residue..." << std::endl;
+		test_jacobi();
+		test_square_roots();
+		test_finite_integral_type();
+		catch_non_residue();
+		std::cout << "test quadratic residue complete" << std::endl;
+	}
+	
+	void run_tests()
+	{
+		test_quadratic_residue();
+	}
+};
+
+#endif // QUADRATIC_RESIDUE_TESTS_H
@@ -0,0 +1,96 @@
+/*
+ *  rational_algorithms_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef RATIONAL_ALGORITHMS_TESTS_H
+#define RATIONAL_ALGORITHMS_TESTS_H
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#include "../big_integer.h"
+#include "../rational.h"
+#include "../rational_algorithms.h"
+
+namespace rational_algorithms_tests
+{
+	using num::big_integer;
+	typedef num::rational<big_integer> Q;
+	typedef num::rational<big_integer, num::lazy_normalization> L;
+
+	void test_sum()
+	{
+		std::vector<num::rational<long long> > small;
+		assert(num::rational_sum(small.begin(), small.end()) == num::rational<long long>(0));
+		small.push_back(num::rational<long long>(1, 6));
+		small.push_back(num::rational<long long>(-1, 3));
+		small.push_back(num::rational<long long>(1, 6));
+		assert(num::rational_sum(small.begin(), small.end()) == num::rational<long long>(0));
+		small.push_back(num::rational<long long>(5, 4));
+		assert(num::rational_sum(small.begin(), small.end()) == num::rational<long long>(5, 4));
+
+		// a signed H(5000), past the pool cutoff, against the sum from left to right
+		std::vector<Q> h;
+		std::vector<L> lazy;
+		Q expected;
+		for (int i = 1; i <= 5000; ++i)
+		{
+			h.push_back(Q(big_integer(i % 7 ? 1 : -1), big_integer(i)));
+			lazy.push_back(L(big_integer(i % 7 ? 1 : -1), big_integer(i)));
+			expected += h.back();
+		}
+		assert(num::rational_sum(h.begin(), h.end(), 1) == expected);
+		assert(num::rational_sum(h.begin(), h.end(), 4) == expected);
+		L s = num::rational_sum(lazy.begin(), lazy.end(), 4);
+		assert(s.numerator() == expected.numerator() && s.denominator() == expected.denominator());
+	}
+
+	void test_product()
+	{
+		std::vector<num::rational<long long> > small;
+		assert(num::rational_product(small.begin(), small.end()) == num::rational<long long>(1));
+
+		// the product of (i+1)/i telescopes to n+1, and of -i/(i+1) to +-1/(n+1)
+		std::vector<Q> t, u;
+		for (int i = 1; i <= 5000; ++i)
+		{
+			t.push_back(Q(big_integer(i + 1), big_integer(i)));
+			u.push_back(Q(big_integer(-i), big_integer(i + 1)));
+		}
+		assert(num::rational_product(t.begin(), t.end(), 1) == Q(big_integer(5001)));
+		assert(num::rational_product(t.begin(), t.end(), 4) == Q(big_integer(5001)));
+		assert(num::rational_product(u.begin(), u.end(), 4) == Q(big_integer(1), big_integer(5001)));
+
+		std::vector<Q> v;
+		Q expected(big_integer(1));
+		for (int i = 1; i <= 200; ++i)
+		{
+			v.push_back(Q(big_integer(i * i + 1), big_integer(2 * i + 3)));
+			expected *= v.back();
+		}
+		assert(num::rational_product(v.begin(), v.end()) == expected);
+		v.push_back(Q(big_integer(0)));
+		assert(num::rational_product(v.begin(), v.end()) == Q(big_integer(0)));
+	}
+
+	void test_rational_algorithms()
+	{
+		std::cout << "test rational_algorithms..." << std::endl;
+		test_sum();
+		test_product();
+		std::cout << "test rational_algorithms complete" << std::endl;
+	}
+
+	void run_tests()
+	{
+		test_rational_algorithms();
+	}
+};
+
+#endif // RATIONAL_ALGORITHMS_TESTS_H
@@ -17,10 +17,12 @@
 
 namespace rational_tests
 {
-	template<class T>
+	template<class T, class N = num::eager_normalization>
 	class test
 	{
 	public:
+		typedef num::rational<T, N> R;
+
 		test()
 		{
 			test_create_assign();
@@ -38,7 +40,7 @@ namespace rational_tests
 		{
 			try
 			{
-				num::rational<T>(T(1), T(0));
+				R(T(1), T(0));
 				return false;
 			}
 			catch (std::runtime_error e)
@@ -49,63 +51,63 @@ namespace rational_tests
 	
 		void test_create_assign()
 		{
-			assert(num::rational<T>() == T(0));
+			assert(R() == T(0));
 		
-			num::rational<T> r(T(2));
+			R r(T(2));
 			assert(r == T(2));
-			assert(r == num::rational<T>(T(2)));
-			assert(r == num::rational<T>(T(2),T(1)));
+			assert(r == R(T(2)));
+			assert(r == R(T(2),T(1)));
 			assert(catch_create_zero_denom_error());
 		
-			num::rational<T> s(T(2),T(5));
-			num::rational<T> t = s;
+			R s(T(2),T(5));
+			R t = s;
 			assert(t == s);
 			assert(r.numerator() == T(2) && r.denominator() == T(1));
 		}
 	
 		void test_unary_negate()
 		{
-			num::rational<T> s(T(2), T(5));
-			num::rational<T> t = -s;
+			R s(T(2), T(5));
+			R t = -s;
 			assert(t != s);
 			assert(t.numerator() == T(-2) && t.denominator() == T(5));
 		}
 	
 		void test_add()
 		{
-			num::rational<T> p(T(-3), T(17));
-			num::rational<T> q(T(5), T(17));
-			assert(p+q == num::rational<T>(T(2), T(17)));
-			assert((p+=num::rational<T>(T(2), T(17))) == num::rational<T>(T(-1), T(17)));
+			R p(T(-3), T(17));
+			R q(T(5), T(17));
+			assert(p+q == R(T(2), T(17)));
+			assert((p+=R(T(2), T(17))) == R(T(-1), T(17)));
 		}
 		
 		void test_subtract()
 		{
-			num::rational<T> p(T(-3), T(17));
-			num::rational<T> q(T(5), T(17));
+			R p(T(-3), T(17));
+			R q(T(5), T(17));
 			
-			assert(p-q == num::rational<T>(T(-8), T(17)));
-			assert(q-p == num::rational<T>(T(8), T(17)));
-			assert(q-(-p) == num::rational<T>(T(2), T(17)));
+			assert(p-q == R(T(-8), T(17)));
+			assert(q-p == R(T(8), T(17)));
+			assert(q-(-p) == R(T(2), T(17)));
 		}
 		
 		void test_multiply()
 		{
-			num::rational<T> p(T(0), T(17));
-			num::rational<T> q(T(1), T(17));
-			num::rational<T> r(T(-1), T(17));
-			num::rational<T> s(T(5), T(17));
-			num::rational<T> t(T(3), T(5));
-			num::rational<T> u(T(3), T(17));
+			R p(T(0), T(17));
+			R q(T(1), T(17));
+			R r(T(-1), T(17));
+			R s(T(5), T(17));
+			R t(T(3), T(5));
+			R u(T(3), T(17));
 			
 			assert(p*q == T(0));
 			assert(s*t == u);
-			assert(q*r == num::rational<T>(T(-1), T(17)*T(17)));
-			assert((p *= q) == num::rational<T>(T(0)));
-			assert((s *= num::rational<T>(T(17))) == T(5));
+			assert(q*r == R(T(-1), T(17)*T(17)));
+			assert((p *= q) == R(T(0)));
+			assert((s *= R(T(17))) == T(5));
 		}
 		
-		bool catch_zero_denominator(const num::rational<T>& p, const num::rational<T>& q)
+		bool catch_zero_denominator(const R& p, const R& q)
 		{
 			try
 			{
@@ -120,19 +122,19 @@ namespace rational_tests
 		
 		void test_divide()
 		{
-			num::rational<T> p(T(0), T(17));
-			num::rational<T> q(T(1), T(17));
-			num::rational<T> r(T(-1), T(17));
-			num::rational<T> s(T(5), T(17));
-			num::rational<T> u(T(3), T(17));
+			R p(T(0), T(17));
+			R q(T(1), T(17));
+			R r(T(-1), T(17));
+			R s(T(5), T(17));
+			R u(T(3), T(17));
 			
 			assert(p/q == T(0));
 			assert(catch_zero_denominator(q, p));
 			assert(q/r == T(-1));
-			assert(s/u == num::rational<T>(5, 3));
-			assert((s /= u) == num::rational<T>(5, 3));			
+			assert(s/u == R(5, 3));
+			assert((s /= u) == R(5, 3));			
 		}
-		bool catch_zero_denominator_inverse(num::rational<T> p)
+		bool catch_zero_denominator_inverse(R p)
 		{
 			try
 			{
@@ -147,29 +149,29 @@ namespace rational_tests
 		
 		void test_invert()
 		{
-			num::rational<T> p(T(0), T(17));
-			num::rational<T> q(T(1), T(17));
-			num::rational<T> r(T(-1), T(17));
+			R p(T(0), T(17));
+			R q(T(1), T(17));
+			R r(T(-1), T(17));
 			
 			assert(catch_zero_denominator_inverse(p));
-			assert(num::rational<T>(5, 3).invert() == num::rational<T>(3, 5));
+			assert(R(5, 3).invert() == R(3, 5));
 			
-			num::rational<T> s(q);
+			R s(q);
 			assert(s.invert() == T(17));
-			assert(num::rational<T>(q).invert() == T(17));
+			assert(R(q).invert() == T(17));
 			assert(q.invert() * r == T(-1));
 		}
 		
 		void test_ordering_operators()
 		{
-			num::rational<T> p(T(1), T(2));
-			num::rational<T> q(T(2), T(3));
-			num::rational<T> r(T(2), T(5));
-			num::rational<T> s(T(3), T(5));
+			R p(T(1), T(2));
+			R q(T(2), T(3));
+			R r(T(2), T(5));
+			R s(T(3), T(5));
 			
-			assert(p == num::rational<T>(T(1), T(2)));
-			assert(p <= num::rational<T>(T(1), T(2)));
-			assert(p >= num::rational<T>(T(1), T(2)));
+			assert(p == R(T(1), T(2)));
+			assert(p <= R(T(1), T(2)));
+			assert(p >= R(T(1), T(2)));
 			assert(p != q);
 			assert(p < q);
 			assert(p <= q);
@@ -180,20 +182,70 @@ namespace rational_tests
 		
 		void test_floor_ceiling()
 		{
-			assert(floor(num::rational<T>(T(1), T(2))) == T(0));
-			assert(ceil(num::rational<T>(T(1), T(2))) == T(1));
-			assert(floor(num::rational<T>(T(10))) == T(10));
-			assert(floor(num::rational<T>(T(50), T(3))) == T(16));
-			assert(ceil(num::rational<T>(T(50), T(3))) == T(17));			
+			assert(floor(R(T(1), T(2))) == T(0));
+			assert(ceil(R(T(1), T(2))) == T(1));
+			assert(floor(R(T(10))) == T(10));
+			assert(floor(R(T(50), T(3))) == T(16));
+			assert(ceil(R(T(50), T(3))) == T(17));			
 		}
 	};
 	
+	// the lazy mode defers reduction, so what is checked is when values
+	//	are reduced as well as what they are
+	template<class T>
+	void test_lazy()
+	{
+		typedef num::rational<T, num::lazy_normalization> R;
+		R p(T(6), T(-4));
+		assert(!p.reduced());
+		R q = p;
+		assert(!q.reduced() && q == R(T(-3), T(2)));
+		assert(p.numerator() == T(-3) && p.denominator() == T(2) && p.reduced());
+
+		// reduced operands give reduced results with no reduction
+		R a(T(1), T(6)), b(T(1), T(10)), c(T(9), T(4));
+		a.numerator();
+		b.numerator();
+		c.numerator();
+		R s = a + b, d = a - b, m = a * c, v = a / c;
+		assert(s.reduced() && d.reduced() && m.reduced() && v.reduced());
+		assert(s.numerator() == T(4) && s.denominator() == T(15));
+		assert(d.numerator() == T(1) && d.denominator() == T(15));
+		assert(m.numerator() == T(3) && m.denominator() == T(8));
+		assert(v.numerator() == T(2) && v.denominator() == T(27));
+		R z = a - a;
+		assert(z.numerator() == T(0) && z.denominator() == T(1));
+
+		// sums of unreduced values are correct and reduce when read
+		R u(T(2), T(4)), w(T(3), T(9));
+		R x = u + w;
+		assert(!x.reduced() && x == R(T(5), T(6)));
+		assert(x.numerator() == T(5) && x.denominator() == T(6));
+
+		assert(R(T(1), T(3)) < R(T(2), T(4)) && R(T(-7), T(2)) < R(T(-3)));
+		assert(floor(R(T(-7), T(2))) == T(-4) && ceil(R(T(-7), T(2))) == T(-3));
+		assert(floor(R(T(-8), T(2))) == T(-4) && ceil(R(T(-8), T(2))) == T(-4));
+
+		// H(20) by accumulation matches the eager result
+		R h;
+		num::rational<T> e;
+		for (int i = 1; i <= 20; ++i)
+		{
+			h += R(T(1), T(i));
+			e += num::rational<T>(T(1), T(i));
+		}
+		assert(h.numerator() == e.numerator() && h.denominator() == e.denominator());
+	}
+
 	void run_tests()
 	{
 		std::cout << "test rational class..." << std::endl;
 		test<int>();
 		test<long>();
 		test<long long>();
+		test<long, num::lazy_normalization>();
+		test<long long, num::lazy_normalization>();
+		test_lazy<long long>();
 		// test<num::rational<int> >();  // this one has issues (doh!)
 		std::cout << "test rational class completed." << std::endl;
 	}
@@ -0,0 +1,66 @@
+/*
+ *  residue_number_system_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef RESIDUE_NUMBER_SYSTEM_TESTS_H
+#define RESIDUE_NUMBER_SYSTEM_TESTS_H
+
+#include <cassert>
+#include <iostream>
+
+#include "../residue_number_system.h"
+
+namespace residue_number_system_tests
+{
+	typedef num::residue_number_system<long long, 1000003, 1000033, 1000037> RNS;
+	
+	void test_create()
+	{
+		RNS a(123456789012LL);
+		assert(a.residue(0) == 123456789012LL % 1000003);
+		typedef num::finite_integral_type<long long, 1000033> FIT;
+		assert((a.get<1>() == FIT(123456789012LL)));
+		assert(RNS(-5).to_signed_integer<long long>() == -5);
+		assert(RNS(-5).to_integer<long long>() == RNS::range<long long>() - 5);
+	}
+	
+	void test_arithmetic()
+	{
+		long long x = 987654321LL, y = 123456789LL;
+		RNS a(x), b(y);
+		assert((a + b).to_integer<long long>() == x + y);
+		assert((a - b).to_integer<long long>() == x - y);
+		assert((b - a).to_signed_integer<long long>() == y - x);
+		assert((a * b).to_integer<long long>() == x * y);
+		assert((-a).to_signed_integer<long long>() == -x);
+		assert(a * b == RNS(x * y));
+	}
+	
+	long long square_mod(size_t, long long m)
+	{
+		return num::multiply_mod(999999999LL % m, 999999999LL % m, m);
+	}
+	
+	void test_generate()
+	{
+		RNS s = RNS::generate(square_mod);
+		assert(s.to_integer<long long>() == 999999999LL * 999999999LL);
+		assert(RNS::generate(square_mod, false) == s);
+	}
+	
+	void run_tests()
+	{
+		std::cout << "test residue number system..." << std::endl;
+		test_create();
+		test_arithmetic();
+		test_generate();
+		std::cout << "test residue number system complete" << std::endl;
+	}
+};
+
+#endif // RESIDUE_NUMBER_SYSTEM_TESTS_H
@@ -0,0 +1,111 @@
+/*
+ *  smallest_prime_factor_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef SMALLEST_PRIME_FACTOR_TESTS_H
+#define SMALLEST_PRIME_FACTOR_TESTS_H
+
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "../smallest_prime_factor.h"
+#include "../prime_factors.h"
+
+namespace smallest_prime_factor_tests
+{
+	void test_table(const num::smallest_prime_factor_table& spf)
+	{
+		assert(spf[2] == 2 && spf[9] == 3 && spf[97] == 97 && spf[91] == 7);
+		assert(spf.is_prime(999983) && !spf.is_prime(1) && !spf.is_prime(999981));
+		
+		std::vector<uint32_t> factors;
+		spf.factor(1, std::back_inserter(factors));
+		assert(factors.empty());
+		spf.factor(720720, std::back_inserter(factors));
+		uint32_t expected[] = { 2, 2, 2, 2, 3, 3, 5, 7, 11, 13 };
+		assert(factors == std::vector<uint32_t>(expected, expected + 10));
+	}
+	
+	void test_factor_range()
+	{
+		num::smallest_prime_factor_table spf(1000000);
+		test_table(spf);
+		
+		// every factorization multiplies back and agrees with prime_factors
+		std::vector<uint64_t> bad(4, 0);
+		spf.factor_range(1, 1000000, [&bad](uint32_t n, const std::vector<uint32_t>& f, unsigned t)
+		{
+			uint64_t product = 1;
+			for (size_t i = 0; i < f.size(); ++i)
+			{
+				if (!num::miller_rabin(f[i])) ++bad[t];
+				product *= f[i];
+			}
+			if (product != n) ++bad[t];
+		}, 4);
+		assert(bad[0] + bad[1] + bad[2] + bad[3] == 0);
+	}
+	
+	void test_mapped_table()
+	{
+		const char* path = "/tmp/num_smallest_prime_factor_test.bin";
+		std::remove(path);
+		{
+			num::smallest_prime_factor_table built(1000000, path);
+			test_table(built);
+		}
+		{	// second time the file is mapped, not rebuilt
+			num::smallest_prime_factor_table mapped(1000000, path);
+			test_table(mapped);
+		}
+		std::remove(path);
+	}
+	
+	void test_corrupted_file()
+	{	// a file of the right size with a bad header and part of its table
+		//	zeroed, as a crash in the middle of a build leaves it
+		const char* path = "/tmp/num_smallest_prime_factor_corrupt.bin";
+		std::remove(path);
+		{
+			num::smallest_prime_factor_table built(1000000, path);
+		}
+		{
+			std::FILE* f = std::fopen(path, "r+b");
+			assert(f);
+			const uint32_t junk = 0;
+			std::fwrite(&junk, sizeof(junk), 1, f);
+			std::fseek(f, 0, SEEK_END);
+			long size = std::ftell(f);
+			std::vector<char> zeros(size / 2, 0);
+			std::fseek(f, size - (long)zeros.size(), SEEK_SET);
+			std::fwrite(&zeros[0], 1, zeros.size(), f);
+			std::fclose(f);
+		}
+		{
+			num::smallest_prime_factor_table rebuilt(1000000, path);
+			test_table(rebuilt);
+			assert(!rebuilt.is_prime(500001) && rebuilt[500001] == 3);
+			num::smallest_prime_factor_table memory(1000000);
+			for (uint32_t n = 2; n <= 1000000; ++n) assert(rebuilt[n] == memory[n]);
+		}
+		std::remove(path);
+	}
+	
+	void run_tests()
+	{
+		std::cout << "test smallest prime factor table..." << std::endl;
+		test_factor_range();
+		test_mapped_table();
+		test_corrupted_file();
+		std::cout << "test smallest prime factor table complete" << std::endl;
+	}
+};
+
+#endif // SMALLEST_PRIME_FACTOR_TESTS_H
@@ -0,0 +1,121 @@
+/*
+ *  wide_int_tests.h
+ *  test
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ */
+
+#ifndef WIDE_INT_TESTS_H
+#define WIDE_INT_TESTS_H
+
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+#include "../integer.h"
+#include "../gcd.h"
+#include "../wide_int.h"
+
+namespace wide_int_tests
+{
+	typedef num::wide_uint<256> u256;
+	typedef num::wide_uint<512> u512;
+	typedef num::wide_int<256> i256;
+
+	// 2^256 - 2^32 - 977, the secp256k1 field prime
+	constexpr u256 secp256k1("115792089237316195423570985008687907853269984665640564039457584007908834671663");
+
+	// everything is usable at compile time
+	static_assert(secp256k1 % u256(1000) == u256(663), "wide_int constexpr remainder");
+	static_assert(u512(secp256k1) * u512(secp256k1) / u512(secp256k1) == u512(secp256k1), "wide_int constexpr divide");
+	static_assert(std::numeric_limits<i256>::digits == 255 && std::numeric_limits<u256>::digits == 256, "wide_int limits");
+
+#ifdef __SIZEOF_INT128__
+	unsigned __int128 value(const num::wide_uint<128>& a)
+	{
+		return ((unsigned __int128)a.limbs[1] << 64) | a.limbs[0];
+	}
+
+	num::wide_uint<128> wide(unsigned __int128 a)
+	{
+		num::wide_uint<128> w;
+		w.limbs[0] = (unsigned long long)a;
+		w.limbs[1] = (unsigned long long)(a >> 64);
+		return w;
+	}
+
+	void test_against_int128()
+	{
+		std::mt19937_64 g(42);
+		for (int i = 0; i < 20000; ++i)
+		{
+			unsigned __int128 a = ((unsigned __int128)g() << 64) | g();
+			unsigned __int128 b = ((unsigned __int128)g() << 64 | g()) >> (g() % 127);
+			if (b == 0) b = 1;
+			num::wide_uint<128> A = wide(a), B = wide(b);
+			assert(value(A + B) == a + b);
+			assert(value(A - B) == a - b);
+			assert(value(A * B) == a * b);
+			assert(value(A / B) == a / b);
+			assert(value(A % B) == a % b);
+			int k = (int)(g() % 128);
+			assert(value(A << k) == a << k);
+			assert(value(A >> k) == a >> k);
+			assert((A < B) == (a < b));
+		}
+	}
+#endif
+
+	void test_arithmetic()
+	{
+		// two's complement behaviour of wide_int
+		i256 a(-7), b(2);
+		assert(a / b == i256(-3) && a % b == i256(-1));
+		assert((a >> 1) == i256(-4));
+		assert(a < b && -a > b);
+		assert(std::numeric_limits<i256>::min() < i256(0));
+		assert(std::numeric_limits<u256>::max() + u256(1) == u256(0));
+
+		// (2^256 - 1)^2 = 2^512 - 2^257 + 1
+		u512 m = num::multiply_full(~u256(), ~u256());
+		assert(m == (u512(0) - (u512(1) << 257) + u512(1)));
+
+		std::ostringstream out;
+		out << secp256k1 << " " << i256(-12345);
+		assert(out.str() == "115792089237316195423570985008687907853269984665640564039457584007908834671663 -12345");
+		assert(u256("340282366920938463463374607431768211456") == u256(1) << 128);
+	}
+
+	void test_generic_algorithms()
+	{	// gcd picks Lehmer's algorithm; power uses the double width product
+		u512 p("340282366920938463463374607431768211507"), q("1000000000000000000000000000057");
+		assert(num::gcd(p * q * u512(6), q * u512(35)) == q);
+		assert(num::gcd(i256(-48), i256(18)) == i256(6));
+
+		num::modular_mult<u256> op(secp256k1);
+		assert(num::power(u256(3), secp256k1 - u256(1), op) == u256(1));
+		u256 inverse = num::power(u256(5), secp256k1 - u256(2), op);
+		assert(num::multiply_mod(inverse, u256(5), secp256k1) == u256(1));
+	}
+
+	void test_wide_int()
+	{
+		std::cout << "test wide int..." << std::endl;
+#ifdef __SIZEOF_INT128__
+		test_against_int128();
+#endif
+		test_arithmetic();
+		test_generic_algorithms();
+		std::cout << "test wide int complete" << std::endl;
+	}
+
+	void run_tests()
+	{
+		test_wide_int();
+	}
+};
+
+#endif // WIDE_INT_TESTS_H
@@ -0,0 +1,560 @@
+/*
+ *  wide_int.h
+ *  num
+ *
+ *  Created by Joe Dumoulin on 10/19/26.
+ *  Copyright 2026 __MyCompanyName__. All rights reserved.
+ *
+ * Fixed width integers of any multiple of 64 bits, held on the stack in
+ *	an array of 64 bit limbs (least significant first) and wrapping on
+ *	overflow like the native types.  wide_uint<Bits> is unsigned and
+ *	wide_int<Bits> is two's complement.  All the arithmetic is constexpr;
+ *	at run time additions use the add-with-carry intrinsic and limb
+ *	products compile to a single 64x64->128 multiply (mulx with BMI2).
+ *	The limbs are a public array, so from C++20 on a wide integer can
+ *	be the T of finite_integral_type<T, BASE>; its products go through
+ *	multiply_mod, and a signed T must still hold twice BASE.
+ */
+
+#ifndef WIDE_INT_H
+#define WIDE_INT_H
+
+#include <string>
+#include <limits>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <cstddef>
+#include <stdint.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define NUM_WIDE_INT_INTRINSICS 1
+#else
+#define NUM_WIDE_INT_INTRINSICS 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define NUM_WIDE_INT_UNROLL _Pragma("GCC unroll 16")
+#else
+#define NUM_WIDE_INT_UNROLL
+#endif
+
+namespace num
+{
+	namespace detail
+	{
+		constexpr bool constant_evaluated()
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_is_constant_evaluated();
+#else
+			return true;
+#endif
+		}
+
+		// a + b + carry, with the carry out left in carry
+		constexpr uint64_t add_with_carry(uint64_t a, uint64_t b, unsigned char& carry)
+		{
+#if NUM_WIDE_INT_INTRINSICS
+			if (!constant_evaluated())
+			{
+				unsigned long long r = 0;
+				carry = _addcarry_u64(carry, a, b, &r);
+				return r;
+			}
+#endif
+			const uint64_t s = a + b;
+			const uint64_t r = s + carry;
+			carry = (unsigned char)((s < a) | (r < s));
+			return r;
+		}
+
+		// a - b - borrow, with the borrow out left in borrow
+		constexpr uint64_t subtract_with_borrow(uint64_t a, uint64_t b, unsigned char& borrow)
+		{
+#if NUM_WIDE_INT_INTRINSICS
+			if (!constant_evaluated())
+			{
+				unsigned long long r = 0;
+				borrow = _subborrow_u64(borrow, a, b, &r);
+				return r;
+			}
+#endif
+			const uint64_t d = a - b;
+			const uint64_t r = d - borrow;
+			borrow = (unsigned char)((a < b) | (d < borrow));
+			return r;
+		}
+
+		// the 128 bit product a * b; returns the low half
+		constexpr uint64_t multiply_wide(uint64_t a, uint64_t b, uint64_t& high)
+		{
+#ifdef __SIZEOF_INT128__
+			const unsigned __int128 p = (unsigned __int128)a * b;
+			high = (uint64_t)(p >> 64);
+			return (uint64_t)p;
+#else
+			const uint64_t a0 = (uint32_t)a, a1 = a >> 32, b0 = (uint32_t)b, b1 = b >> 32;
+			const uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+			const uint64_t middle = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+			high = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+			return (middle << 32) | (uint32_t)p00;
+#endif
+		}
+
+		constexpr int leading_zeros64(uint64_t x)
+		{	// x != 0
+			int n = 0;
+			for (uint64_t bit = (uint64_t)1 << 63; (x & bit) == 0; bit >>= 1) ++n;
+			return n;
+		}
+
+		// Knuth's algorithm D on fixed arrays of Digit, least significant
+		//	first; u has room for one extra digit, and u and v are both
+		//	overwritten.  every quotient digit is estimated by dividing a
+		//	TwiceDigit by a Digit.
+		template<typename Digit, typename TwiceDigit>
+		constexpr void knuth_divide(Digit* u, size_t m, Digit* v, size_t n, Digit* q, Digit* r)
+		{
+			const int width = 8 * sizeof(Digit);
+			while (m > 0 && u[m - 1] == 0) --m;
+			while (n > 0 && v[n - 1] == 0) --n;
+			if (m < n)
+			{
+				for (size_t i = 0; i < m; ++i) r[i] = u[i];
+				return;
+			}
+			if (n == 1)
+			{
+				TwiceDigit rem = 0;
+				for (size_t i = m; i-- > 0; )
+				{
+					const TwiceDigit t = (rem << width) | u[i];
+					q[i] = (Digit)(t / v[0]);
+					rem = t % v[0];
+				}
+				r[0] = (Digit)rem;
+				return;
+			}
+
+			int s = 0;
+			for (Digit top = v[n - 1]; (top >> (width - 1)) == 0; top <<= 1) ++s;
+			Digit* vn = v;
+			for (size_t i = n; i-- > 0; )
+			{
+				vn[i] = (Digit)(v[i] << s) | (s && i > 0 ? (Digit)(v[i - 1] >> (width - s)) : 0);
+			}
+			u[m] = s ? (Digit)(u[m - 1] >> (width - s)) : 0;
+			for (size_t i = m; i-- > 0; )
+			{
+				u[i] = (Digit)(u[i] << s) | (s && i > 0 ? (Digit)(u[i - 1] >> (width - s)) : 0);
+			}
+
+			const TwiceDigit base = (TwiceDigit)1 << width;
+			for (size_t j = m - n + 1; j-- > 0; )
+			{
+				const TwiceDigit top = ((TwiceDigit)u[j + n] << width) | u[j + n - 1];
+				TwiceDigit qhat = top / vn[n - 1];
+				TwiceDigit rhat = top % vn[n - 1];
+				while (qhat >= base || qhat * vn[n - 2] > ((rhat << width) | u[j + n - 2]))
+				{
+					--qhat;
+					rhat += vn[n - 1];
+					if (rhat >= base) break;
+				}
+				// u[j..j+n] -= qhat * vn
+				Digit borrow = 0, carry = 0;
+				for (size_t i = 0; i < n; ++i)
+				{
+					const TwiceDigit p = qhat * vn[i] + carry;
+					carry = (Digit)(p >> width);
+					const Digit low = (Digit)p;
+					const Digit d = u[i + j] - low;
+					const Digit b1 = d > u[i + j];
+					u[i + j] = d - borrow;
+					borrow = b1 | (u[i + j] > d);
+				}
+				const Digit d = u[j + n] - carry;
+				const Digit b1 = d > u[j + n];
+				u[j + n] = d - borrow;
+				if (b1 | (u[j + n] > d))
+				{	// qhat was one too large; add vn back
+					--qhat;
+					Digit c = 0;
+					for (size_t i = 0; i < n; ++i)
+					{
+						const TwiceDigit t = (TwiceDigit)u[i + j] + vn[i] + c;
+						u[i + j] = (Digit)t;
+						c = (Digit)(t >> width);
+					}
+					u[j + n] += c;
+				}
+				q[j] = (Digit)qhat;
+			}
+			for (size_t i = 0; i < n; ++i)
+			{
+				r[i] = (Digit)(u[i] >> s) | (s ? (Digit)((TwiceDigit)u[i + 1] << (width - s)) : 0);
+			}
+		}
+	}
+
+	template<size_t Bits, bool Signed>
+	struct basic_wide_int
+	{
+		static_assert(Bits >= 64 && Bits % 64 == 0, "num::basic_wide_int - Bits must be a positive multiple of 64.");
+		static const size_t N = Bits / 64;
+		typedef basic_wide_int self_type;
+
+		uint64_t limbs[N];
+
+		constexpr basic_wide_int() : limbs() {}
+
+		// native integers convert with sign extension, as between native types
+		template<typename I, typename = typename std::enable_if<std::is_integral<I>::value>::type>
+		constexpr basic_wide_int(I value) : limbs()
+		{
+			const uint64_t fill = value < I(0) ? ~(uint64_t)0 : 0;
+			limbs[0] = (uint64_t)value;
+			for (size_t i = 1; i < N; ++i) limbs[i] = fill;
+			if (sizeof(I) > 8 && N > 1) limbs[1] = (uint64_t)(value >> 32 >> 32);
+		}
+
+		// other widths convert by truncation or extension
+		template<size_t B, bool S>
+		constexpr explicit basic_wide_int(const basic_wide_int<B, S>& w) : limbs()
+		{
+			const uint64_t fill = w.negative() ? ~(uint64_t)0 : 0;
+			for (size_t i = 0; i < N; ++i) limbs[i] = i < basic_wide_int<B, S>::N ? w.limbs[i] : fill;
+		}
+
+		// decimal digits with an optional sign
+		constexpr explicit basic_wide_int(const char* s) : limbs()
+		{
+			bool minus = false;
+			if (*s == '+' || *s == '-') minus = *s++ == '-';
+			if (*s == 0) throw std::runtime_error("num::basic_wide_int - no digits.");
+			for (; *s; ++s)
+			{
+				if (*s < '0' || *s > '9') throw std::runtime_error("num::basic_wide_int - invalid digit.");
+				*this = *this * self_type(10) + self_type(*s - '0');
+			}
+			if (minus) *this = -*this;
+		}
+
+		template<typename I, typename = typename std::enable_if<std::is_integral<I>::value>::type>
+		constexpr explicit operator I() const
+		{
+			if (sizeof(I) > 8 && N > 1)
+			{
+				typedef typename std::make_unsigned<I>::type U;
+				return I((U(limbs[1]) << 32 << 32) | U(limbs[0]));
+			}
+			return I(limbs[0]);
+		}
+
+		constexpr bool negative() const { return Signed && (limbs[N - 1] >> 63) != 0; }
+
+		constexpr bool is_zero() const
+		{
+			for (size_t i = 0; i < N; ++i) if (limbs[i] != 0) return false;
+			return true;
+		}
+
+		// significant bits of the value, read as unsigned
+		constexpr int bit_length() const
+		{
+			for (size_t i = N; i-- > 0; )
+			{
+				if (limbs[i] != 0) return (int)(64 * i + 64 - detail::leading_zeros64(limbs[i]));
+			}
+			return 0;
+		}
+
+		// arithmetic, wrapping modulo 2^Bits
+		constexpr self_type& operator+=(const self_type& b)
+		{
+			unsigned char carry = 0;
+			NUM_WIDE_INT_UNROLL
+			for (size_t i = 0; i < N; ++i) limbs[i] = detail::add_with_carry(limbs[i], b.limbs[i], carry);
+			return *this;
+		}
+
+		constexpr self_type& operator-=(const self_type& b)
+		{
+			unsigned char borrow = 0;
+			NUM_WIDE_INT_UNROLL
+			for (size_t i = 0; i < N; ++i) limbs[i] = detail::subtract_with_borrow(limbs[i], b.limbs[i], borrow);
+			return *this;
+		}
+
+		// schoolbook, keeping only the low N limbs of the product
+		constexpr self_type& operator*=(const self_type& b)
+		{
+			uint64_t r[N] = {};
+			for (size_t i = 0; i < N; ++i)
+			{
+				uint64_t carry = 0;
+				NUM_WIDE_INT_UNROLL
+				for (size_t j = 0; i + j < N; ++j)
+				{
+					uint64_t high = 0;
+					uint64_t low = detail::multiply_wide(limbs[i], b.limbs[j], high);
+					unsigned char c = 0;
+					low = detail::add_with_carry(low, carry, c);
+					high += c;
+					c = 0;
+					r[i + j] = detail::add_with_carry(r[i + j], low, c);
+					carry = high + c;
+				}
+			}
+			for (size_t i = 0; i < N; ++i) limbs[i] = r[i];
+			return *this;
+		}
+
+		constexpr self_type& operator/=(const self_type& b)
+		{
+			self_type q, r;
+			divide(*this, b, q, r);
+			return *this = q;
+		}
+
+		constexpr self_type& operator%=(const self_type& b)
+		{
+			self_type q, r;
+			divide(*this, b, q, r);
+			return *this = r;
+		}
+
+		constexpr self_type& operator&=(const self_type& b) { for (size_t i = 0; i < N; ++i) limbs[i] &= b.limbs[i]; return *this; }
+		constexpr self_type& operator|=(const self_type& b) { for (size_t i = 0; i < N; ++i) limbs[i] |= b.limbs[i]; return *this; }
+		constexpr self_type& operator^=(const self_type& b) { for (size_t i = 0; i < N; ++i) limbs[i] ^= b.limbs[i]; return *this; }
+
+		constexpr self_type& operator<<=(int k)
+		{
+			if (k < 0) return *this >>= -k;
+			if (k >= (int)Bits) return *this = self_type();
+			const size_t whole = (size_t)k / 64;
+			const int bits = k % 64;
+			for (size_t i = N; i-- > 0; )
+			{
+				uint64_t v = i >= whole ? limbs[i - whole] << bits : 0;
+				if (bits && i > whole) v |= limbs[i - whole - 1] >> (64 - bits);
+				limbs[i] = v;
+			}
+			return *this;
+		}
+
+		// arithmetic shift for wide_int, logical for wide_uint
+		constexpr self_type& operator>>=(int k)
+		{
+			if (k < 0) return *this <<= -k;
+			const uint64_t fill = negative() ? ~(uint64_t)0 : 0;
+			if (k >= (int)Bits)
+			{
+				for (size_t i = 0; i < N; ++i) limbs[i] = fill;
+				return *this;
+			}
+			const size_t whole = (size_t)k / 64;
+			const int bits = k % 64;
+			for (size_t i = 0; i < N; ++i)
+			{
+				const uint64_t lo = i + whole < N ? limbs[i + whole] : fill;
+				const uint64_t hi = i + whole + 1 < N ? limbs[i + whole + 1] : fill;
+				limbs[i] = bits ? (lo >> bits) | (hi << (64 - bits)) : lo;
+			}
+			return *this;
+		}
+
+		constexpr self_type operator-() const { return self_type() - *this; }
+		constexpr self_type operator~() const
+		{
+			self_type r(*this);
+			for (size_t i = 0; i < N; ++i) r.limbs[i] = ~r.limbs[i];
+			return r;
+		}
+
+		constexpr self_type& operator++() { return *this += self_type(1); }
+		constexpr self_type& operator--() { return *this -= self_type(1); }
+		constexpr self_type operator++(int) { self_type t(*this); ++*this; return t; }
+		constexpr self_type operator--(int) { self_type t(*this); --*this; return t; }
+
+		friend constexpr self_type operator+(self_type a, const self_type& b) { return a += b; }
+		friend constexpr self_type operator-(self_type a, const self_type& b) { return a -= b; }
+		friend constexpr self_type operator*(self_type a, const self_type& b) { return a *= b; }
+		friend constexpr self_type operator/(self_type a, const self_type& b) { return a /= b; }
+		friend constexpr self_type operator%(self_type a, const self_type& b) { return a %= b; }
+		friend constexpr self_type operator&(self_type a, const self_type& b) { return a &= b; }
+		friend constexpr self_type operator|(self_type a, const self_type& b) { return a |= b; }
+		friend constexpr self_type operator^(self_type a, const self_type& b) { return a ^= b; }
+		friend constexpr self_type operator<<(self_type a, int k) { return a <<= k; }
+		friend constexpr self_type operator>>(self_type a, int k) { return a >>= k; }
+
+		friend constexpr bool operator==(const self_type& a, const self_type& b)
+		{
+			for (size_t i = 0; i < N; ++i) if (a.limbs[i] != b.limbs[i]) return false;
+			return true;
+		}
+		friend constexpr bool operator!=(const self_type& a, const self_type& b) { return !(a == b); }
+		friend constexpr bool operator<(const self_type& a, const self_type& b)
+		{
+			if (a.negative() != b.negative()) return a.negative();
+			for (size_t i = N; i-- > 0; )
+			{
+				if (a.limbs[i] != b.limbs[i]) return a.limbs[i] < b.limbs[i];
+			}
+			return false;
+		}
+		friend constexpr bool operator>(const self_type& a, const self_type& b) { return b < a; }
+		friend constexpr bool operator<=(const self_type& a, const self_type& b) { return !(b < a); }
+		friend constexpr bool operator>=(const self_type& a, const self_type& b) { return !(a < b); }
+
+		friend std::ostream& operator<<(std::ostream& out, const self_type& a)
+		{
+			return out << a.to_string();
+		}
+
+		std::string to_string() const
+		{
+			typedef basic_wide_int<Bits, false> magnitude_type;
+			magnitude_type m(negative() ? -*this : *this);
+			std::string s;
+			const magnitude_type ten19(10000000000000000000ULL);
+			do
+			{
+				magnitude_type q, r;
+				magnitude_type::divide(m, ten19, q, r);
+				uint64_t chunk = r.limbs[0];
+				for (int i = 0; i < 19 && (!q.is_zero() || chunk != 0); ++i)
+				{
+					s.push_back(char('0' + chunk % 10));
+					chunk /= 10;
+				}
+				m = q;
+			} while (!m.is_zero());
+			if (s.empty()) s = "0";
+			if (negative()) s.push_back('-');
+			return std::string(s.rbegin(), s.rend());
+		}
+
+		// q = a/b truncated toward zero and r = a - q*b
+		static constexpr void divide(const self_type& a, const self_type& b, self_type& q, self_type& r)
+		{
+			if (b.is_zero()) throw std::runtime_error("num::basic_wide_int - division by zero.");
+			const bool na = a.negative(), nb = b.negative();
+			divide_unsigned(na ? -a : a, nb ? -b : b, q, r);
+			if (na != nb) q = -q;
+			if (na) r = -r;
+		}
+
+	private:
+		// Knuth's algorithm D, on 64 bit digits where there is a 128 bit
+		//	type to divide with and on 32 bit digits otherwise.
+		static constexpr void divide_unsigned(const self_type& a, const self_type& b, self_type& q, self_type& r)
+		{
+#ifdef __SIZEOF_INT128__
+			typedef uint64_t digit;
+			typedef unsigned __int128 twice_digit;
+#else
+			typedef uint32_t digit;
+			typedef uint64_t twice_digit;
+#endif
+			const size_t per_limb = 64 / (8 * sizeof(digit));
+			const size_t D = N * per_limb;
+			digit u[N * per_limb + 1] = {}, v[N * per_limb] = {}, w[N * per_limb] = {}, rem[N * per_limb] = {};
+			for (size_t i = 0; i < D; ++i)
+			{
+				u[i] = (digit)(a.limbs[i / per_limb] >> (8 * sizeof(digit) * (i % per_limb)));
+				v[i] = (digit)(b.limbs[i / per_limb] >> (8 * sizeof(digit) * (i % per_limb)));
+			}
+			detail::knuth_divide<digit, twice_digit>(u, D, v, D, w, rem);
+			q = self_type();
+			r = self_type();
+			for (size_t i = 0; i < D; ++i)
+			{
+				q.limbs[i / per_limb] |= (uint64_t)w[i] << (8 * sizeof(digit) * (i % per_limb));
+				r.limbs[i / per_limb] |= (uint64_t)rem[i] << (8 * sizeof(digit) * (i % per_limb));
+			}
+		}
+	};
+
+	template<size_t Bits, bool Signed>
+	const size_t basic_wide_int<Bits, Signed>::N;
+
+	template<size_t Bits>
+	using wide_uint = basic_wide_int<Bits, false>;
+
+	template<size_t Bits>
+	using wide_int = basic_wide_int<Bits, true>;
+
+	// found by Lehmer's gcd through argument dependent lookup
+	template<size_t Bits, bool Signed>
+	constexpr int bit_length(const basic_wide_int<Bits, Signed>& x)
+	{
+		return x.bit_length();
+	}
+
+	// the whole 2 Bits product of two unsigned values
+	template<size_t Bits>
+	constexpr wide_uint<2 * Bits> multiply_full(const wide_uint<Bits>& a, const wide_uint<Bits>& b)
+	{
+		const size_t N = Bits / 64;
+		wide_uint<2 * Bits> r;
+		for (size_t i = 0; i < N; ++i)
+		{
+			uint64_t carry = 0;
+			NUM_WIDE_INT_UNROLL
+			for (size_t j = 0; j < N; ++j)
+			{
+				uint64_t high = 0;
+				uint64_t low = detail::multiply_wide(a.limbs[i], b.limbs[j], high);
+				unsigned char c = 0;
+				low = detail::add_with_carry(low, carry, c);
+				high += c;
+				c = 0;
+				r.limbs[i + j] = detail::add_with_carry(r.limbs[i + j], low, c);
+				carry = high + c;
+			}
+			r.limbs[i + N] = carry;
+		}
+		return r;
+	}
+
+	// (a * b) % m without overflow, through the double width product.
+	//	power(x, n, modular_mult<T>(m)) picks this up for any Bits.
+	template<size_t Bits, bool Signed>
+	basic_wide_int<Bits, Signed> multiply_mod(const basic_wide_int<Bits, Signed>& a,
+											  const basic_wide_int<Bits, Signed>& b,
+											  const basic_wide_int<Bits, Signed>& m)
+	{
+		typedef wide_uint<Bits> magnitude_type;
+		const bool minus = a.negative() != b.negative();
+		wide_uint<2 * Bits> p = multiply_full(magnitude_type(a.negative() ? -a : a), magnitude_type(b.negative() ? -b : b));
+		basic_wide_int<Bits, Signed> r(p % wide_uint<2 * Bits>(magnitude_type(m.negative() ? -m : m)));
+		return minus ? -r : r;
+	}
+};
+
+namespace std
+{
+	template<size_t Bits, bool Signed>
+	class numeric_limits<num::basic_wide_int<Bits, Signed> >
+	{
+		typedef num::basic_wide_int<Bits, Signed> type;
+	public:
+		static const bool is_specialized = true;
+		static const bool is_signed = Signed;
+		static const bool is_integer = true;
+		static const bool is_exact = true;
+		static const bool is_bounded = true;
+		static const bool is_modulo = true;
+		static const int radix = 2;
+		static const int digits = Signed ? (int)Bits - 1 : (int)Bits;
+		static const int digits10 = digits * 30103 / 100000;
+		static constexpr type min() { return Signed ? type(1) << (int)(Bits - 1) : type(); }
+		static constexpr type max() { return Signed ? ~(type(1) << (int)(Bits - 1)) : ~type(); }
+		static constexpr type lowest() { return min(); }
+	};
+}
+
+#endif // WIDE_INT_H